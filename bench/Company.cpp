@@ -0,0 +1,31 @@
+// relative includes
+#include "Company.h"
+
+using employee::date_t;
+using employee::EmployeeDescr;
+using employee::EmployeeType;
+using employee::uuid_t;
+
+//! Register company
+std::vector<uuid_t> bench::add_company(employee::EmployeeManager& manager, size_t count) {
+    // 1.Employees: every tenth one is foreman, every hundredth one is manager
+    std::vector<EmployeeDescr> descriptions(count,
+                                            {EmployeeType::WORKER, 1000.0, date_t{2020, 1, 1}});
+    for (size_t i = 0; i < descriptions.size(); i += 10) {
+        descriptions[i].type = (i % 100 == 0) ? EmployeeType::MANAGER : EmployeeType::FOREMAN;
+    }
+
+    const std::vector<uuid_t> ids = manager.add_employees(descriptions).first;
+
+    // 2.Hierarchy
+    std::vector<std::pair<uuid_t, uuid_t>> relations;
+    relations.reserve(ids.size());
+
+    for (size_t i = 1; i < ids.size(); ++i) {
+        const size_t chief = (i % 100 == 0) ? 0 : (i % 10 == 0) ? i / 100 * 100 : i / 10 * 10;
+        relations.emplace_back(ids[chief], ids[i]);
+    }
+    manager.add_subordinations(relations);
+
+    return ids;
+}
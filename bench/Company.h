@@ -0,0 +1,22 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeManager.h>
+
+// C++ includes
+#include <cstddef>
+#include <vector>
+
+namespace bench
+{
+
+/**
+ * @brief Register company: managers -> foremen -> workers (1:10:100), all managers are under the
+ * top one; every employee is hired on 2020-01-01 with base salary 1000
+ * @param manager employees manager
+ * @param count number of employees
+ * @return employees unique identifiers (the top manager is the first one)
+ */
+std::vector<employee::uuid_t> add_company(employee::EmployeeManager& manager, size_t count);
+
+} // namespace bench
@@ -0,0 +1,100 @@
+// relative includes
+#include "OrgChart.h"
+
+// C++ includes
+#include <random>
+
+using employee::date_t;
+using employee::EmployeeType;
+
+//! Get name of org chart shape
+const char* bench::to_string(OrgShape shape) {
+    switch (shape) {
+        case OrgShape::WIDE:
+            return "wide";
+
+        case OrgShape::DEEP:
+            return "deep";
+
+        case OrgShape::BALANCED:
+            return "balanced";
+
+        case OrgShape::SKEWED:
+            return "skewed";
+    }
+
+    return "unknown";
+}
+
+//! Generate synthetic org chart
+bench::OrgChart bench::generate_org_chart(OrgShape shape, size_t count, uint64_t seed) {
+    std::mt19937_64                        random(seed);
+    std::uniform_real_distribution<double> salaries(1000.0, 5000.0);
+    std::uniform_int_distribution<int>     months(0, 12 * 25 - 1);
+    std::uniform_int_distribution<int>     percents(0, 99);
+
+    OrgChart chart;
+    chart.descriptions.resize(count);
+    chart.chiefs.resize(count, NO_CHIEF);
+
+    // 1.Attributes which do not depend on shape
+    for (employee::EmployeeDescr& description : chart.descriptions) {
+        description.type        = EmployeeType::WORKER;
+        description.base_salary = salaries(random);
+        description.hire_date   = date_t{2000, 1, 1} + boost::gregorian::months(months(random));
+    }
+
+    // 2.Hierarchy and categories (only managers and foremen have subordinates)
+    std::vector<size_t> tickets; // Chiefs candidates, every one is repeated by his fan-out + 1
+
+    for (size_t i = 0; i < count; ++i) {
+        EmployeeType& type = chart.descriptions[i].type;
+
+        switch (shape) {
+            case OrgShape::WIDE:
+                type = (i == 0 || i % 1000 == 0) ? EmployeeType::MANAGER
+                       : (i % 100 == 0)          ? EmployeeType::FOREMAN
+                                                 : EmployeeType::WORKER;
+                chart.chiefs[i] = (i == 0) ? NO_CHIEF : 0;
+                break;
+
+            case OrgShape::DEEP:
+                type = (i + 1 == count) ? EmployeeType::WORKER
+                       : (i % 2 == 0)   ? EmployeeType::MANAGER
+                                        : EmployeeType::FOREMAN;
+                chart.chiefs[i] = (i == 0) ? NO_CHIEF : i - 1;
+                break;
+
+            case OrgShape::BALANCED: {
+                const size_t first_subordinate = BALANCED_FAN_OUT * i + 1;
+                type = (first_subordinate >= count)                        ? EmployeeType::WORKER
+                       : (BALANCED_FAN_OUT * first_subordinate + 1 < count) ? EmployeeType::MANAGER
+                                                                            : EmployeeType::FOREMAN;
+                chart.chiefs[i] = (i == 0) ? NO_CHIEF : (i - 1) / BALANCED_FAN_OUT;
+                break;
+            }
+
+            case OrgShape::SKEWED: {
+                const int percent = percents(random);
+                type = (i == 0 || percent < 5) ? EmployeeType::MANAGER
+                       : (percent < 20)        ? EmployeeType::FOREMAN
+                                               : EmployeeType::WORKER;
+
+                if (i > 0) {
+                    // Rich get richer: chief is chosen in proportion to his fan-out
+                    const size_t chief = tickets[std::uniform_int_distribution<size_t>(
+                        0, tickets.size() - 1)(random)];
+
+                    chart.chiefs[i] = chief;
+                    tickets.push_back(chief);
+                }
+                if (type != EmployeeType::WORKER) {
+                    tickets.push_back(i);
+                }
+                break;
+            }
+        }
+    }
+
+    return chart;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bench
+{
+
+/**
+ * @class OrgShape
+ * @brief Class that enumerates shapes of synthetic org charts
+ */
+enum class OrgShape {
+    WIDE = 0, //!< Flat: everybody is direct subordinate of the only manager
+    DEEP,     //!< Chain: every employee is direct subordinate of the previous one
+    BALANCED, //!< Complete tree with fan-out `BALANCED_FAN_OUT`
+    SKEWED    //!< Random tree with power-law fan-out (preferential attachment)
+};
+
+//!< Fan-out of balanced org chart
+constexpr size_t BALANCED_FAN_OUT = 10;
+
+//!< Chief index of top-level employee
+constexpr size_t NO_CHIEF = SIZE_MAX;
+
+/**
+ * @struct OrgChart
+ * @brief Synthetic org chart (every chief precedes his subordinates)
+ */
+struct OrgChart {
+    std::vector<employee::EmployeeDescr> descriptions; //!< Employees descriptions
+    std::vector<size_t>                  chiefs;       //!< Chiefs indices (`NO_CHIEF` for top)
+};
+
+/**
+ * @brief Get name of org chart shape
+ * @param shape shape
+ * @return name (lower case)
+ */
+const char* to_string(OrgShape shape);
+
+/**
+ * @brief Generate synthetic org chart
+ * Base salaries and hire dates are random, so are subordinates of skewed chart; generation is
+ * deterministic for the same seed.
+ * @param shape shape
+ * @param count number of employees
+ * @param seed seed of pseudo-random generator
+ * @return org chart
+ */
+OrgChart generate_org_chart(OrgShape shape, size_t count, uint64_t seed = 1);
+
+} // namespace bench
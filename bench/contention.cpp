@@ -0,0 +1,245 @@
+// google benchmark includes
+#include <benchmark/benchmark.h>
+
+// lib includes
+#include <employee_lib/EmployeeManager.h>
+
+// relative includes
+#include "Company.h"
+
+// C++ includes
+#include <future>
+#include <memory>
+#include <vector>
+
+using employee::date_t;
+using employee::EmployeeDescr;
+using employee::EmployeeManager;
+using employee::EmployeeManagerConfig;
+using employee::EmployeeType;
+using employee::IdGeneratorType;
+using employee::uuid_t;
+
+namespace
+{
+
+//! Number of employees in benchmark registry
+constexpr size_t EMPLOYEES_COUNT = 10000;
+
+//! Number of reads per one write in mixed benchmark
+constexpr size_t READS_PER_WRITE = 1000;
+
+//! Date of salary calculation
+const date_t CALC_DATE{2030, 1, 1};
+
+/**
+ * @struct Registry
+ * @brief Shared registry for all benchmark threads: managers -> foremen -> workers (1:10:100)
+ */
+struct Registry {
+    EmployeeManager     manager;
+    std::vector<uuid_t> ids;
+
+    Registry() {
+        // 1.Employees
+        std::vector<EmployeeDescr> descriptions;
+        descriptions.reserve(EMPLOYEES_COUNT);
+
+        for (size_t i = 0; i < EMPLOYEES_COUNT; ++i) {
+            const EmployeeType type = (i % 100 == 0)  ? EmployeeType::MANAGER
+                                      : (i % 10 == 0) ? EmployeeType::FOREMAN
+                                                      : EmployeeType::WORKER;
+
+            descriptions.push_back({type, 1000.0 + i, date_t{2020, 1, 1}});
+        }
+
+        ids = manager.add_employees(descriptions).first;
+
+        // 2.Hierarchy
+        std::vector<std::pair<uuid_t, uuid_t>> relations;
+        relations.reserve(EMPLOYEES_COUNT);
+
+        uuid_t last_manager, last_foreman;
+        for (size_t i = 0; i < EMPLOYEES_COUNT; ++i) {
+            if (descriptions[i].type == EmployeeType::MANAGER) {
+                last_manager = last_foreman = ids[i];
+            } else if (descriptions[i].type == EmployeeType::FOREMAN) {
+                relations.emplace_back(last_manager, ids[i]);
+                last_foreman = ids[i];
+            } else {
+                relations.emplace_back(last_foreman, ids[i]);
+            }
+        }
+
+        manager.add_subordinations(relations);
+    }
+
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+};
+
+} // namespace
+
+//! Concurrent `find_employee` calls
+static void BM_find_employee(benchmark::State& state) {
+    Registry& registry = Registry::instance();
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.manager.find_employee(registry.ids[i % EMPLOYEES_COUNT]));
+        i += 7;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_find_employee)->ThreadRange(1, 32)->UseRealTime();
+
+//! Concurrent `get_chief` calls
+static void BM_get_chief(benchmark::State& state) {
+    Registry& registry = Registry::instance();
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.manager.get_chief(registry.ids[i % EMPLOYEES_COUNT]));
+        i += 7;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_get_chief)->ThreadRange(1, 32)->UseRealTime();
+
+//! Concurrent `calculate_employee_salary` calls (memoized after the first pass)
+static void BM_calculate_employee_salary(benchmark::State& state) {
+    Registry& registry = Registry::instance();
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.manager.calculate_employee_salary(
+            registry.ids[i % EMPLOYEES_COUNT], CALC_DATE));
+        i += 7;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_calculate_employee_salary)->ThreadRange(1, 32)->UseRealTime();
+
+//! Fan-out of salary queries of the first department (manager, foremen and workers) after change
+//! of its hierarchy: one by one calls (Arg 0), asynchronous calls (Arg 1) or asynchronous batch
+//! (Arg 2)
+static void BM_salary_fan_out(benchmark::State& state) {
+    Registry& registry = Registry::instance();
+
+    const std::vector<uuid_t> department(registry.ids.begin(), registry.ids.begin() + 100);
+    const uuid_t              worker   = registry.ids[11];
+    const uuid_t              foreman1 = registry.ids[10];
+    const uuid_t              foreman2 = registry.ids[20];
+
+    std::vector<std::shared_future<std::pair<double, bool>>> futures(department.size());
+
+    for (auto _ : state) {
+        // Worker is moved between foremen, so salaries of department are recalculated
+        const uuid_t chief = *registry.manager.get_chief(worker);
+        registry.manager.remove_subordination(chief, worker);
+        registry.manager.add_subordination(chief == foreman1 ? foreman2 : foreman1, worker);
+
+        if (state.range(0) == 0) {
+            for (const uuid_t& id : department) {
+                benchmark::DoNotOptimize(registry.manager.calculate_employee_salary(id, CALC_DATE));
+            }
+        } else if (state.range(0) == 1) {
+            for (size_t i = 0; i < department.size(); ++i) {
+                futures[i] = registry.manager.calculate_employee_salary_async(department[i],
+                                                                              CALC_DATE);
+            }
+            for (const auto& future : futures) {
+                benchmark::DoNotOptimize(future.get());
+            }
+        } else {
+            benchmark::DoNotOptimize(
+                registry.manager.calculate_employee_salaries_async(department, CALC_DATE).get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * department.size());
+}
+BENCHMARK(BM_salary_fan_out)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+
+//! Concurrent reads with one hierarchy write per `READS_PER_WRITE` reads
+static void BM_mixed_read_write(benchmark::State& state) {
+    Registry& registry = Registry::instance();
+
+    // Every thread moves its own worker between two foremen
+    const uuid_t worker   = registry.ids[100 * (state.thread_index() + 1) + 1];
+    const uuid_t foreman1 = registry.ids[10];
+    const uuid_t foreman2 = registry.ids[20];
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        if (i % READS_PER_WRITE == 0) {
+            const std::optional<uuid_t> chief = registry.manager.get_chief(worker);
+            if (chief) {
+                registry.manager.remove_subordination(*chief, worker);
+                registry.manager.add_subordination(*chief == foreman1 ? foreman2 : foreman1,
+                                                   worker);
+            }
+        } else {
+            benchmark::DoNotOptimize(
+                registry.manager.get_chief(registry.ids[i % EMPLOYEES_COUNT]));
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mixed_read_write)->ThreadRange(1, 32)->UseRealTime();
+
+//! Registrations and removals of employees alternated with salary queries over registry of given
+//! size (every change makes data version newer than the last snapshot)
+static void BM_alternating_write_query(benchmark::State& state) {
+    EmployeeManager manager{EmployeeManagerConfig{IdGeneratorType::FAST}};
+
+    const std::vector<uuid_t> ids =
+        bench::add_company(manager, static_cast<size_t>(state.range(0)));
+
+    const EmployeeDescr description{EmployeeType::WORKER, 1000.0, date_t{2020, 1, 1}};
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const uuid_t id = manager.add_employee(description).first;
+        benchmark::DoNotOptimize(manager.calculate_employee_salary(ids[i % ids.size()], CALC_DATE));
+
+        manager.remove_employee(id);
+        benchmark::DoNotOptimize(manager.calculate_employee_salary(ids[i % ids.size()], CALC_DATE));
+
+        i += 7;
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(BM_alternating_write_query)
+    ->Arg(10000)
+    ->Arg(200000)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+//! Concurrent registrations and removals of employees (ingestion) with single-partition storage
+//! (Arg 1) or default sharded one (Arg 16)
+static void BM_concurrent_add_remove(benchmark::State& state) {
+    static std::unique_ptr<EmployeeManager> manager;
+
+    if (state.thread_index() == 0) {
+        EmployeeManagerConfig config{IdGeneratorType::FAST};
+        config.storage_shards = static_cast<size_t>(state.range(0));
+
+        manager = std::make_unique<EmployeeManager>(config);
+    }
+
+    const EmployeeDescr description{EmployeeType::WORKER, 1000.0, CALC_DATE};
+
+    for (auto _ : state) {
+        const uuid_t id = manager->add_employee(description).first;
+        manager->remove_employee(id);
+    }
+    state.SetItemsProcessed(2 * state.iterations());
+
+    if (state.thread_index() == 0) {
+        manager.reset();
+    }
+}
+BENCHMARK(BM_concurrent_add_remove)->Arg(1)->Arg(16)->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,239 @@
+// google benchmark includes
+#include <benchmark/benchmark.h>
+
+// lib includes
+#include <employee_lib/EmployeeManager.h>
+
+// relative includes
+#include "OrgChart.h"
+
+// C++ includes
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+using bench::OrgChart;
+using bench::OrgShape;
+using employee::date_t;
+using employee::EmployeeDescr;
+using employee::EmployeeManager;
+using employee::EmployeeType;
+using employee::uuid_t;
+
+namespace
+{
+
+//!< Numbers of employees of benchmark registries
+constexpr std::array<size_t, 4> SIZES = {1000, 10000, 100000, 1000000};
+
+//!< Shapes of benchmark registries
+constexpr std::array<OrgShape, 4> SHAPES = {OrgShape::WIDE, OrgShape::DEEP, OrgShape::BALANCED,
+                                            OrgShape::SKEWED};
+
+//!< Employees categories
+constexpr std::array<EmployeeType, 3> TYPES = {EmployeeType::WORKER, EmployeeType::FOREMAN,
+                                               EmployeeType::MANAGER};
+
+//! Date of salary calculation
+const date_t CALC_DATE{2030, 1, 1};
+
+//! Get name of employee category
+const char* to_string(EmployeeType type) {
+    switch (type) {
+        case EmployeeType::WORKER:
+            return "worker";
+
+        case EmployeeType::FOREMAN:
+            return "foreman";
+
+        case EmployeeType::MANAGER:
+            return "manager";
+    }
+
+    return "unknown";
+}
+
+/**
+ * @struct Registry
+ * @brief Registry filled by synthetic org chart
+ */
+struct Registry {
+    OrgShape shape; //!< Shape of org chart
+    size_t   size;  //!< Number of employees
+
+    EmployeeManager     manager; //!< Registry
+    std::vector<uuid_t> ids;     //!< Unique identifiers (in order of org chart)
+    std::vector<size_t> chiefs;  //!< Chiefs indices (in order of org chart)
+
+    //!< Probe of every category: employee with the largest subtree (index of org chart)
+    std::array<size_t, 3> probes;
+
+    //!< Direct subordinate of every probe relinked to change its subtree (probe itself if he
+    //!< has no subordinates)
+    std::array<size_t, 3> relinked;
+
+    Registry(OrgShape shape, size_t size) :
+        shape(shape),
+        size(size),
+        manager(employee::EmployeeManagerConfig{employee::IdGeneratorType::FAST}) {
+        // 1.Employees and hierarchy by batches
+        const OrgChart chart = bench::generate_org_chart(shape, size);
+
+        ids    = manager.add_employees(chart.descriptions).first;
+        chiefs = chart.chiefs;
+
+        std::vector<std::pair<uuid_t, uuid_t>> relations;
+        relations.reserve(size);
+
+        for (size_t i = 0; i < size; ++i) {
+            if (chiefs[i] != bench::NO_CHIEF) {
+                relations.emplace_back(ids[chiefs[i]], ids[i]);
+            }
+        }
+        manager.add_subordinations(relations);
+
+        // 2.Probes (reverse scan: subordinates before chiefs)
+        std::vector<size_t> subtree_sizes(size, 1);
+        for (size_t i = size; i > 0; --i) {
+            if (chiefs[i - 1] != bench::NO_CHIEF) {
+                subtree_sizes[chiefs[i - 1]] += subtree_sizes[i - 1];
+            }
+        }
+
+        std::array<bool, 3> found{};
+        for (size_t i = 0; i < size; ++i) {
+            const size_t type = static_cast<size_t>(chart.descriptions[i].type);
+            if (!found[type] || subtree_sizes[i] > subtree_sizes[probes[type]]) {
+                probes[type] = i;
+                found[type]  = true;
+            }
+        }
+
+        relinked = probes;
+        for (size_t i = size; i > 0; --i) {
+            for (size_t type = 0; type < TYPES.size(); ++type) {
+                if (chiefs[i - 1] == probes[type]) {
+                    relinked[type] = i - 1;
+                }
+            }
+        }
+    }
+
+    //! Get registry of shape and size (the last one is cached, so benchmarks of the same
+    //! registry are registered one after another)
+    static Registry& instance(OrgShape shape, size_t size) {
+        static std::unique_ptr<Registry> registry;
+
+        if (registry == nullptr || registry->shape != shape || registry->size != size) {
+            registry.reset();
+            registry = std::make_unique<Registry>(shape, size);
+        }
+
+        return *registry;
+    }
+
+    //! Remove and add again relation of employee with his chief (if he has one)
+    void relink(size_t index) {
+        if (chiefs[index] != bench::NO_CHIEF) {
+            manager.remove_subordination(ids[chiefs[index]], ids[index]);
+            manager.add_subordination(ids[chiefs[index]], ids[index]);
+        }
+    }
+};
+
+//! Registration of new employees
+void BM_add_employee(benchmark::State& state, OrgShape shape, size_t size) {
+    Registry& registry = Registry::instance(shape, size);
+
+    std::vector<uuid_t> added;
+    for (auto _ : state) {
+        added.push_back(
+            registry.manager.add_employee({EmployeeType::WORKER, 1000.0, CALC_DATE}).first);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    // Registry is restored for the following benchmarks
+    for (const uuid_t& id : added) {
+        registry.manager.remove_employee(id);
+    }
+}
+
+//! Addition of relation (every iteration removes and adds again relation of probe subordinate
+//! of manager, so registry is not changed)
+void BM_add_subordination(benchmark::State& state, OrgShape shape, size_t size) {
+    Registry&    registry = Registry::instance(shape, size);
+    const size_t index    = registry.relinked[static_cast<size_t>(EmployeeType::MANAGER)];
+
+    for (auto _ : state) {
+        registry.relink(index);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//! All subordinates of top-level employee (the whole registry but him)
+void BM_get_all_subordinates(benchmark::State& state, OrgShape shape, size_t size) {
+    Registry& registry = Registry::instance(shape, size);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.manager.get_all_subordinates(registry.ids[0]));
+    }
+    state.SetItemsProcessed(state.iterations() * (size - 1));
+}
+
+//! Salary of probe employee of category: memoized one or the first one after change of his
+//! subtree (which includes rebuilding of snapshot of registry)
+void BM_calculate_employee_salary(benchmark::State& state,
+                                  OrgShape          shape,
+                                  size_t            size,
+                                  EmployeeType      type,
+                                  bool              after_change) {
+    Registry&     registry = Registry::instance(shape, size);
+    const uuid_t& id       = registry.ids[registry.probes[static_cast<size_t>(type)]];
+    const size_t  relinked = registry.relinked[static_cast<size_t>(type)];
+
+    registry.manager.calculate_employee_salary(id, CALC_DATE);
+
+    for (auto _ : state) {
+        if (after_change) {
+            registry.relink(relinked);
+        }
+        benchmark::DoNotOptimize(registry.manager.calculate_employee_salary(id, CALC_DATE));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//! Register benchmarks of all shapes and sizes (grouped by registry)
+bool register_benchmarks() {
+    for (OrgShape shape : SHAPES) {
+        for (size_t size : SIZES) {
+            const std::string suffix =
+                std::string("/") + bench::to_string(shape) + "/" + std::to_string(size);
+
+            benchmark::RegisterBenchmark(("BM_add_employee" + suffix).c_str(), BM_add_employee,
+                                         shape, size);
+            benchmark::RegisterBenchmark(("BM_add_subordination" + suffix).c_str(),
+                                         BM_add_subordination, shape, size);
+            benchmark::RegisterBenchmark(("BM_get_all_subordinates" + suffix).c_str(),
+                                         BM_get_all_subordinates, shape, size);
+
+            for (EmployeeType type : TYPES) {
+                for (bool after_change : {false, true}) {
+                    const std::string name = "BM_calculate_employee_salary" + suffix + "/" +
+                                             to_string(type) +
+                                             (after_change ? "/after_change" : "/memoized");
+
+                    benchmark::RegisterBenchmark(name.c_str(), BM_calculate_employee_salary,
+                                                 shape, size, type, after_change);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+//! Benchmarks are registered before `main` of benchmark library
+[[maybe_unused]] const bool REGISTERED = register_benchmarks();
+
+} // namespace
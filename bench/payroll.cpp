@@ -0,0 +1,83 @@
+// google benchmark includes
+#include <benchmark/benchmark.h>
+
+// lib includes
+#include <employee_lib/EmployeeManager.h>
+
+// relative includes
+#include "Company.h"
+
+// C++ includes
+#include <vector>
+
+using employee::date_t;
+using employee::EmployeeManager;
+using employee::EmployeeManagerConfig;
+using employee::IdGeneratorType;
+using employee::uuid_t;
+
+namespace
+{
+
+//! Number of employees in benchmark registry
+constexpr size_t EMPLOYEES_COUNT = 100000;
+
+//! Date of salary calculation
+const date_t CALC_DATE{2030, 1, 1};
+
+} // namespace
+
+//! Whole-company payroll with different number of worker threads (0 for sequential calculation)
+static void BM_parallel_total_payroll(benchmark::State& state) {
+    EmployeeManager manager{
+        EmployeeManagerConfig{IdGeneratorType::FAST, nullptr, static_cast<size_t>(state.range(0))}};
+
+    const std::vector<uuid_t> ids = bench::add_company(manager, EMPLOYEES_COUNT);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.calculate_total_payroll(CALC_DATE));
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_parallel_total_payroll)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+//! Whole-company payroll by built-in salary policy (Arg 0) or by the same rules loaded as runtime
+//! coefficients table (Arg 1)
+static void BM_total_payroll_policy(benchmark::State& state) {
+    EmployeeManagerConfig config{IdGeneratorType::FAST};
+    if (state.range(0) != 0) {
+        config.salary_policy = employee::DEFAULT_SALARY_POLICY;
+    }
+
+    EmployeeManager           manager{config};
+    const std::vector<uuid_t> ids = bench::add_company(manager, EMPLOYEES_COUNT);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.calculate_total_payroll(CALC_DATE));
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_total_payroll_policy)->Arg(0)->Arg(1)->UseRealTime();
+
+//! Five-year payroll forecast: month by month vs single series traversal
+static void BM_payroll_forecast(benchmark::State& state) {
+    EmployeeManager manager{EmployeeManagerConfig{IdGeneratorType::FAST}};
+    bench::add_company(manager, EMPLOYEES_COUNT / 10);
+
+    const date_t last = CALC_DATE + boost::gregorian::years(5) - boost::gregorian::months(1);
+
+    std::vector<date_t> dates;
+    for (date_t date = CALC_DATE; date <= last; date += boost::gregorian::months(1)) {
+        dates.push_back(date);
+    }
+
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            benchmark::DoNotOptimize(manager.calculate_total_payroll(dates));
+        } else {
+            benchmark::DoNotOptimize(manager.calculate_payroll_series(CALC_DATE, last));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * dates.size());
+}
+BENCHMARK(BM_payroll_forecast)->Arg(0)->Arg(1);
@@ -0,0 +1,92 @@
+// google benchmark includes
+#include <benchmark/benchmark.h>
+
+// lib includes
+#include <employee_lib/EmployeeManager.h>
+#include <employee_lib/EmployeeRegistryView.h>
+
+// relative includes
+#include "Company.h"
+
+// C++ includes
+#include <filesystem>
+#include <string>
+
+using employee::date_t;
+using employee::EmployeeManager;
+using employee::EmployeeManagerConfig;
+using employee::EmployeeRegistryView;
+using employee::EmployeeType;
+using employee::IdGeneratorType;
+using employee::uuid_t;
+
+//! Save registry of given size to file (managers -> foremen -> workers, 1:10:100)
+static void save_registry(const std::string& path, size_t count) {
+    EmployeeManager manager{EmployeeManagerConfig{IdGeneratorType::FAST}};
+    bench::add_company(manager, count);
+    manager.save(path);
+}
+
+//! Cold start: load of registry saved to file
+static void BM_load_registry(benchmark::State& state) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "bench_employee_registry.bin").string();
+    save_registry(path, static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        EmployeeManager manager{};
+        benchmark::DoNotOptimize(manager.load(path));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_load_registry)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//! Cold start: opening of read-only view over registry file and the first payroll by it
+static void BM_open_registry_view(benchmark::State& state) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "bench_employee_registry_view.bin").string();
+    save_registry(path, static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        EmployeeRegistryView view{};
+        benchmark::DoNotOptimize(view.open(path));
+        benchmark::DoNotOptimize(view.calculate_total_payroll(date_t{2025, 1, 1}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_open_registry_view)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//! Registration and relation change with change journal (Arg 1) or without it (Arg 0)
+static void BM_journaled_changes(benchmark::State& state) {
+    // Journal files of all generations are kept in their own directory
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "bench_employee_journal";
+    const std::string registry_path = (directory / "registry.bin").string();
+    const std::string journal_path  = (directory / "journal.log").string();
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    EmployeeManager manager{EmployeeManagerConfig{IdGeneratorType::FAST}};
+    if (state.range(0) != 0) {
+        manager.open_journal(registry_path, journal_path);
+    }
+
+    const uuid_t chief = manager.add_employee({EmployeeType::MANAGER, 1000.0, date_t{2020, 1, 1}})
+                             .first;
+
+    for (auto _ : state) {
+        const uuid_t id = manager.add_employee({EmployeeType::WORKER, 1000.0, date_t{2020, 1, 1}})
+                              .first;
+        benchmark::DoNotOptimize(manager.add_subordination(chief, id));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+
+    manager.flush_journal();
+    std::filesystem::remove_all(directory);
+}
+BENCHMARK(BM_journaled_changes)->Arg(0)->Arg(1);
@@ -4,17 +4,31 @@
 #include <boost/uuid/uuid.hpp>
 
 // C++ includes
+#include <functional>
+#include <future>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 // relative includes
 #include "EmployeeDescr.h"
+#include "EmployeeManagerConfig.h"
+#include "EmployeeManagerStats.h"
+#include "Month.h"
+#include "PayrollByType.h"
 
 namespace employee
 {
 
 using uuid_t = boost::uuids::uuid;
 
+//!< Visitor of employees (e.g. subordinates)
+using EmployeeVisitor = std::function<void(const uuid_t&)>;
+
+//!< Completion callback of asynchronous salary calculation (month salary and success flag)
+using SalaryCallback = std::function<void(const std::pair<double, bool>&)>;
+
 /**
  * @class EmployeeManager
  * @brief Class that provides an API for work with employee logic
@@ -32,6 +46,12 @@ public:
      */
     EmployeeManager();
 
+    /**
+     * @brief Construct an EmployeeManager object with specific settings
+     * @param config settings
+     */
+    explicit EmployeeManager(const EmployeeManagerConfig& config);
+
     /**
      * @brief Destruct an EmployeeManager object
      */
@@ -44,6 +64,32 @@ public:
      */
     std::pair<uuid_t, bool> add_employee(const EmployeeDescr& description);
 
+    /**
+     * @brief Registrate new employee with caller-supplied unique identifier (e.g. for import)
+     * @param id unique employee identifier (must not be nil or already registered)
+     * @param description employee description
+     * @return success status
+     */
+    bool add_employee(const uuid_t& id, const EmployeeDescr& description);
+
+    /**
+     * @brief Registrate many new employees at once (all or nothing)
+     * @param descriptions employees descriptions
+     * @return unique employees identifiers (in order of descriptions) and success status
+     */
+    std::pair<std::vector<uuid_t>, bool>
+    add_employees(const std::vector<EmployeeDescr>& descriptions);
+
+    /**
+     * @brief Registrate many new employees with caller-supplied unique identifiers at once (all
+     * or nothing)
+     * @param ids unique employees identifiers (must not be nil, repeated or already registered)
+     * @param descriptions employees descriptions (in order of identifiers)
+     * @return success status
+     */
+    bool add_employees(const std::vector<uuid_t>&        ids,
+                       const std::vector<EmployeeDescr>& descriptions);
+
     /**
      * @brief Remove employee from registration list
      * @param id unique employee identifier
@@ -66,6 +112,15 @@ public:
      */
     bool add_subordination(const uuid_t& chief, const uuid_t& subordinate);
 
+    /**
+     * @brief Add many relations between chiefs and subordinates at once (all or nothing)
+     * The same rules as for `add_subordination` are applied to every relation, hierarchical
+     * cycles are checked for the whole batch at once
+     * @param relations "chief-->subordinate" pairs
+     * @return were added or not
+     */
+    bool add_subordinations(const std::vector<std::pair<uuid_t, uuid_t>>& relations);
+
     /**
      * @brief Remove subordination relation between chief and subordinate
      * @param chief сhief unique identifier
@@ -81,6 +136,14 @@ public:
      */
     std::optional<uuid_t> get_chief(const uuid_t& id) const;
 
+    /**
+     * @brief Check if employee is direct or indirect subordinate of chief
+     * @param chief chief unique identifier
+     * @param id employee unique identifier
+     * @return is subordinate or not
+     */
+    bool is_subordinate(const uuid_t& chief, const uuid_t& id) const;
+
     /**
      * @brief Get employee direct subordinates
      * @param id employee unique identifier
@@ -95,6 +158,56 @@ public:
      */
     std::vector<uuid_t> get_all_subordinates(const uuid_t& id) const;
 
+    /**
+     * @brief Visit employee direct subordinates without their copying
+     * Attention! Visitor is called under hierarchy lock, so it must not call EmployeeManager.
+     * @param id employee unique identifier
+     * @param visitor visitor of every direct subordinate
+     * @return employee exists or not
+     */
+    bool visit_direct_subordinates(const uuid_t& id, const EmployeeVisitor& visitor) const;
+
+    /**
+     * @brief Visit employee all subordinates (in pre-order) without their copying and without
+     * any allocation during traversal
+     * Attention! Visitor is called under hierarchy lock, so it must not call EmployeeManager.
+     * @param id employee unique identifier
+     * @param visitor visitor of every subordinate
+     * @return employee exists or not
+     */
+    bool visit_all_subordinates(const uuid_t& id, const EmployeeVisitor& visitor) const;
+
+    /**
+     * @brief Write employee direct subordinates to output iterator
+     * @param id employee unique identifier
+     * @param out output iterator
+     * @return output iterator past the last written subordinate
+     */
+    template<typename OutputIt>
+    OutputIt get_direct_subordinates(const uuid_t& id, OutputIt out) const {
+        visit_direct_subordinates(id, [&out](const uuid_t& sub) { *out++ = sub; });
+        return out;
+    }
+
+    /**
+     * @brief Write employee all subordinates to output iterator
+     * @param id employee unique identifier
+     * @param out output iterator
+     * @return output iterator past the last written subordinate
+     */
+    template<typename OutputIt>
+    OutputIt get_all_subordinates(const uuid_t& id, OutputIt out) const {
+        visit_all_subordinates(id, [&out](const uuid_t& sub) { *out++ = sub; });
+        return out;
+    }
+
+    /**
+     * @brief Count employee all subordinates (without subordinates traversal)
+     * @param id employee unique identifier
+     * @return number of all subordinates
+     */
+    size_t count_all_subordinates(const uuid_t& id) const;
+
     /**
      * @brief Calculate employee salary
      * @param id employee unique identifier
@@ -103,6 +216,225 @@ public:
      */
     std::pair<double, bool> calculate_employee_salary(const uuid_t& id, const date_t& date) const;
 
+    /**
+     * @brief Calculate employee salary (month given by ordinal, see `to_month`)
+     * @param id employee unique identifier
+     * @param month month ordinal
+     * @return month salary and success flag
+     */
+    std::pair<double, bool> calculate_employee_salary(const uuid_t& id, month_t month) const;
+
+    /**
+     * @brief Calculate employee salary asynchronously by internal executor (concurrent requests
+     * of the same employee and month are calculated once)
+     * @param id employee unique identifier
+     * @param date date
+     * @return future of month salary and success flag (it holds exception of calculation, e.g.
+     * `std::bad_alloc`)
+     */
+    std::shared_future<std::pair<double, bool>>
+    calculate_employee_salary_async(const uuid_t& id, const date_t& date) const;
+
+    /**
+     * @brief Calculate employee salary asynchronously (month given by ordinal, see `to_month`)
+     * @param id employee unique identifier
+     * @param month month ordinal
+     * @return future of month salary and success flag (it holds exception of calculation, e.g.
+     * `std::bad_alloc`)
+     */
+    std::shared_future<std::pair<double, bool>>
+    calculate_employee_salary_async(const uuid_t& id, month_t month) const;
+
+    /**
+     * @brief Calculate employee salary asynchronously with completion callback
+     * @param id employee unique identifier
+     * @param date date
+     * @param callback completion callback (called by thread of internal executor, must not
+     * block it)
+     */
+    void calculate_employee_salary_async(const uuid_t&  id,
+                                         const date_t&  date,
+                                         SalaryCallback callback) const;
+
+    /**
+     * @brief Calculate employee salary asynchronously with completion callback (month given by
+     * ordinal, see `to_month`)
+     * @param id employee unique identifier
+     * @param month month ordinal
+     * @param callback completion callback (called by thread of internal executor, must not
+     * block it)
+     */
+    void calculate_employee_salary_async(const uuid_t&  id,
+                                         month_t        month,
+                                         SalaryCallback callback) const;
+
+    /**
+     * @brief Calculate salaries of batch of employees asynchronously (the whole batch is
+     * calculated over the same data, subtrees shared by its employees are calculated once)
+     * @param ids employees unique identifiers
+     * @param date date
+     * @return future of month salary and success flag of every employee (in order of ids; it
+     * holds exception of calculation, e.g. `std::bad_alloc`)
+     */
+    std::future<std::vector<std::pair<double, bool>>>
+    calculate_employee_salaries_async(const std::vector<uuid_t>& ids, const date_t& date) const;
+
+    /**
+     * @brief Calculate salaries of batch of employees asynchronously (month given by ordinal,
+     * see `to_month`)
+     * @param ids employees unique identifiers
+     * @param month month ordinal
+     * @return future of month salary and success flag of every employee (in order of ids; it
+     * holds exception of calculation, e.g. `std::bad_alloc`)
+     */
+    std::future<std::vector<std::pair<double, bool>>>
+    calculate_employee_salaries_async(const std::vector<uuid_t>& ids, month_t month) const;
+
+    /**
+     * @brief Calculate total salary of all employees (whole-company payroll)
+     * @param date date
+     * @return total month salary and success flag
+     */
+    std::pair<double, bool> calculate_total_payroll(const date_t& date) const;
+
+    /**
+     * @brief Calculate total salary of all employees (month given by ordinal, see `to_month`)
+     * @param month month ordinal
+     * @return total month salary and success flag
+     */
+    std::pair<double, bool> calculate_total_payroll(month_t month) const;
+
+    /**
+     * @brief Calculate total salary of all employees for a batch of dates (e.g. payroll
+     * projection for a year ahead); all dates are calculated over the same data version
+     * @param dates dates
+     * @return total month salary and success flag for every date
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_total_payroll(const std::vector<date_t>& dates) const;
+
+    /**
+     * @brief Calculate total salary of all employees for a batch of months given by ordinals
+     * @param months months ordinals
+     * @return total month salary and success flag for every month
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_total_payroll(const std::vector<month_t>& months) const;
+
+    /**
+     * @brief Calculate total salary and headcount of every employee category (in a single pass
+     * over all employees)
+     * @param date date
+     * @return payroll of every category and success flag
+     */
+    std::pair<PayrollByType, bool> calculate_payroll_by_type(const date_t& date) const;
+
+    /**
+     * @brief Calculate total salary and headcount of every employee category (month given by
+     * ordinal, see `to_month`)
+     * @param month month ordinal
+     * @return payroll of every category and success flag
+     */
+    std::pair<PayrollByType, bool> calculate_payroll_by_type(month_t month) const;
+
+    /**
+     * @brief Calculate employee salary for every month of range (e.g. forecast for a few years
+     * ahead) in a single subordinates traversal
+     * @param id employee unique identifier
+     * @param from the first month (day value is ignored)
+     * @param to the last month (inclusive, day value is ignored)
+     * @return month salary and success flag for every month (empty if `from` is after `to`)
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_salary_series(const uuid_t& id, const date_t& from, const date_t& to) const;
+
+    /**
+     * @brief Calculate employee salary for every month of range given by ordinals
+     * @param id employee unique identifier
+     * @param first the first month ordinal
+     * @param last the last month ordinal (inclusive)
+     * @return month salary and success flag for every month (empty if `first` is after `last`)
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_salary_series(const uuid_t& id, month_t first, month_t last) const;
+
+    /**
+     * @brief Calculate total salary of all employees for every month of range in a single
+     * traversal
+     * @param from the first month (day value is ignored)
+     * @param to the last month (inclusive, day value is ignored)
+     * @return total month salary and success flag for every month (empty if `from` is after `to`)
+     */
+    std::vector<std::pair<double, bool>> calculate_payroll_series(const date_t& from,
+                                                                  const date_t& to) const;
+
+    /**
+     * @brief Calculate total salary of all employees for every month of range given by ordinals
+     * @param first the first month ordinal
+     * @param last the last month ordinal (inclusive)
+     * @return total month salary and success flag for every month (empty if `first` is after
+     * `last`)
+     */
+    std::vector<std::pair<double, bool>> calculate_payroll_series(month_t first,
+                                                                  month_t last) const;
+
+    /**
+     * @brief Save all employees and hierarchy to file (compact versioned binary format)
+     * Consistent copy of data is written, concurrent changes are not blocked during writing.
+     * Target file is replaced only when the whole file is written.
+     * @param path file path
+     * @return success status
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Load all employees and hierarchy from file written by `save` (all or nothing)
+     * Attention! Registry must be empty and change journal must not be opened.
+     * @param path file path
+     * @return success status
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Restore registry from registry file and change journal and keep writing every
+     * following change to journal
+     * Registry file (if exists) is loaded, changes of journal made after it are replayed, then
+     * journal is compacted (registry file is rewritten and journal is started anew). Changes are
+     * written to disk in background every `journal_flush_interval` (see `flush_journal`). Once
+     * journal file can't be started or written, all changes are rejected until the next
+     * successful `compact_journal`.
+     * Attention! Registry must be empty; on failure it may be left partially restored.
+     * @param registry_path path of registry file
+     * @param journal_path base path of change journal (every compaction starts new file with
+     * generation suffix, e.g. "journal.log.2", and removes older ones after registry file is
+     * synced)
+     * @return success status
+     */
+    bool open_journal(const std::string& registry_path, const std::string& journal_path);
+
+    /**
+     * @brief Write to disk and sync all changes made before the call (concurrent callers share
+     * the same sync)
+     * @return success status (false if journal is not opened or writing failed)
+     */
+    bool flush_journal();
+
+    /**
+     * @brief Compact change journal: rewrite registry file by actual data and start journal
+     * anew (changes are not blocked during writing of registry file)
+     * @return success status (false if journal is not opened or writing failed)
+     */
+    bool compact_journal();
+
+    /**
+     * @brief Get statistics collected since construction: calls and latencies of every
+     * operation, waiting and holding times of locks and numbers of nodes visited by walks over
+     * hierarchy
+     * Statistics are collected only if library is built with `EMPLOYEE_LIB_STATS` option.
+     * @return statistics (`enabled` is false and all values are zero without option)
+     */
+    EmployeeManagerStats stats() const;
+
 private:
     class PrivateData;
     std::unique_ptr<PrivateData> p_data_;
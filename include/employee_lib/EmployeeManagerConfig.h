@@ -0,0 +1,60 @@
+#pragma once
+
+// C++ includes
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+// relative includes
+#include "SalaryPolicy.h"
+
+namespace employee
+{
+
+/**
+ * @class IdGeneratorType
+ * @brief Class that enumerates possible generators of employees unique identifiers
+ */
+enum class IdGeneratorType {
+    SECURE = 0, //!< Random UUID (version 4) from OS entropy source
+    FAST        //!< Random UUID (version 4) from pseudo-random generator (non-cryptographic)
+};
+
+/**
+ * @class EmployeeManagerConfig
+ * @brief Class that describes EmployeeManager settings
+ */
+struct EmployeeManagerConfig {
+    IdGeneratorType id_generator = IdGeneratorType::SECURE; //!< Generator of unique identifiers
+
+    //!< Memory resource for columns of employees attributes (nullptr for default new/delete
+    //!< one); must outlive the manager
+    std::pmr::memory_resource* memory_resource = nullptr;
+
+    //!< Number of worker threads for parallel calculations over large subtrees (0 for sequential
+    //!< calculations)
+    size_t worker_threads = 0;
+
+    //!< Interval of background writing of change journal to disk (changes of the last interval
+    //!< can be lost on crash unless `EmployeeManager::flush_journal` is called)
+    std::chrono::milliseconds journal_flush_interval{10};
+
+    //!< Number of change journal records after which journal is compacted in background (0 for
+    //!< manual compaction only)
+    size_t journal_compaction_threshold = 0;
+
+    //!< Number of independently locked partitions of employees storage: registrations and
+    //!< removals of employees without relations from different partitions run in parallel
+    size_t storage_shards = 16;
+
+    //!< Number of threads of executor of asynchronous salary calculations (started by the first
+    //!< asynchronous request)
+    size_t async_threads = 2;
+
+    //!< Salary policy, e.g. per-tenant rules loaded by `parse_salary_policy` (nullopt for built-in
+    //!< one, whose rules are compile-time constants)
+    std::optional<SalaryPolicy> salary_policy = std::nullopt;
+};
+
+} // namespace employee
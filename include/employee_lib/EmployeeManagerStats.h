@@ -0,0 +1,207 @@
+#pragma once
+
+// C++ includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace employee
+{
+
+/**
+ * @class ManagerOperation
+ * @brief Class that enumerates operations of EmployeeManager with collected statistics
+ * (overloads by date and by month ordinal are counted together)
+ */
+enum class ManagerOperation {
+    ADD_EMPLOYEE = 0,          //!< `add_employee`
+    ADD_EMPLOYEES,             //!< `add_employees`
+    REMOVE_EMPLOYEE,           //!< `remove_employee`
+    FIND_EMPLOYEE,             //!< `find_employee`
+    ADD_SUBORDINATION,         //!< `add_subordination`
+    ADD_SUBORDINATIONS,        //!< `add_subordinations`
+    REMOVE_SUBORDINATION,      //!< `remove_subordination`
+    GET_CHIEF,                 //!< `get_chief`
+    IS_SUBORDINATE,            //!< `is_subordinate`
+    GET_DIRECT_SUBORDINATES,   //!< `get_direct_subordinates`
+    GET_ALL_SUBORDINATES,      //!< `get_all_subordinates`
+    VISIT_DIRECT_SUBORDINATES, //!< `visit_direct_subordinates`
+    VISIT_ALL_SUBORDINATES,    //!< `visit_all_subordinates`
+    COUNT_ALL_SUBORDINATES,    //!< `count_all_subordinates`
+    CALCULATE_EMPLOYEE_SALARY, //!< `calculate_employee_salary`
+    CALCULATE_TOTAL_PAYROLL,   //!< `calculate_total_payroll` (single month or batch)
+    CALCULATE_PAYROLL_BY_TYPE, //!< `calculate_payroll_by_type`
+    CALCULATE_SALARY_SERIES,   //!< `calculate_salary_series`
+    CALCULATE_PAYROLL_SERIES,  //!< `calculate_payroll_series`
+    SAVE,                      //!< `save`
+    LOAD,                      //!< `load`
+    COUNT                      //!< Number of operations (not an operation)
+};
+
+//!< Number of operations with collected statistics
+constexpr size_t MANAGER_OPERATIONS_COUNT = static_cast<size_t>(ManagerOperation::COUNT);
+
+/**
+ * @class HierarchyTraversal
+ * @brief Class that enumerates walks over hierarchy with counted visited nodes
+ */
+enum class HierarchyTraversal {
+    SUBORDINATES = 0, //!< Walk over all subordinates of employee
+    CHIEFS,           //!< Walk over chiefs chains (salaries invalidation, subtree sizes update)
+    CYCLE_CHECK,      //!< Walk over chiefs chains on validation of hierarchical cycles
+    RELABEL,          //!< Euler tour numbering of subtree
+    COUNT             //!< Number of walks (not a walk)
+};
+
+//!< Number of walks over hierarchy with counted visited nodes
+constexpr size_t HIERARCHY_TRAVERSALS_COUNT = static_cast<size_t>(HierarchyTraversal::COUNT);
+
+/**
+ * @class Histogram
+ * @brief Class that describes HDR-style histogram of values (nanoseconds or numbers of nodes)
+ *
+ * Buckets are log-linear: values below 8 are counted exactly and every power of two above is
+ * split into 8 buckets, so value is known with relative error below 12.5%. Values of
+ * 2^`MAX_BITS` and above are counted by the last bucket.
+ */
+struct Histogram {
+    //!< Number of bits of sub-bucket index (8 buckets per power of two)
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+
+    //!< Number of bits of the largest distinguished value (about 18 minutes in nanoseconds)
+    static constexpr unsigned MAX_BITS = 40;
+
+    //!< Number of buckets (the last one is for values of 2^`MAX_BITS` and above)
+    static constexpr size_t BUCKETS_COUNT =
+        ((MAX_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + 1;
+
+    uint64_t count = 0; //!< Number of values
+    uint64_t sum   = 0; //!< Sum of values
+    uint64_t max   = 0; //!< The largest value
+
+    std::array<uint64_t, BUCKETS_COUNT> buckets{}; //!< Number of values of every bucket
+
+    /**
+     * @brief Get bucket of value
+     * @param value value
+     * @return bucket index
+     */
+    static size_t bucket(uint64_t value);
+
+    /**
+     * @brief Get the largest value of bucket
+     * @param index bucket index
+     * @return value
+     */
+    static constexpr uint64_t bucket_upper_bound(size_t index) {
+        constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        if (index == BUCKETS_COUNT - 1) {
+            return UINT64_MAX;
+        }
+
+        const unsigned shift = static_cast<unsigned>(index >> SUB_BUCKET_BITS) - 1;
+        const uint64_t lower = (SUB_BUCKETS + (index & (SUB_BUCKETS - 1))) << shift;
+
+        return lower + (uint64_t{1} << shift) - 1;
+    }
+
+    /**
+     * @brief Get value of percentile (upper bound of its bucket, but not above the largest value)
+     * @param percentile percentile in range [0, 100]
+     * @return value (0 if histogram is empty)
+     */
+    uint64_t value_at_percentile(double percentile) const {
+        if (count == 0) {
+            return 0;
+        }
+
+        // Rank of value (1-based) rounded up, so the 100th percentile is the largest value
+        const double rank  = percentile / 100.0 * static_cast<double>(count);
+        uint64_t     limit = static_cast<uint64_t>(rank);
+        if (static_cast<double>(limit) < rank || limit == 0) {
+            ++limit;
+        }
+
+        uint64_t counted = 0;
+        for (size_t i = 0; i < BUCKETS_COUNT; ++i) {
+            counted += buckets[i];
+            if (counted >= limit) {
+                return bucket_upper_bound(i) < max ? bucket_upper_bound(i) : max;
+            }
+        }
+
+        return max;
+    }
+
+    /**
+     * @brief Get mean value
+     * @return mean value (0 if histogram is empty)
+     */
+    double mean() const {
+        return count != 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+};
+
+/**
+ * @class LockStats
+ * @brief Class that describes statistics of shared mutex (nanoseconds)
+ */
+struct LockStats {
+    Histogram shared_wait; //!< Waiting for shared lock
+    Histogram shared_hold; //!< Holding of shared lock
+    Histogram unique_wait; //!< Waiting for unique lock
+    Histogram unique_hold; //!< Holding of unique lock
+};
+
+/**
+ * @class OperationStats
+ * @brief Class that describes statistics of operation
+ */
+struct OperationStats {
+    uint64_t  calls = 0; //!< Number of calls
+    Histogram latency;   //!< Latency of calls (nanoseconds)
+};
+
+/**
+ * @class EmployeeManagerStats
+ * @brief Class that describes statistics collected by EmployeeManager
+ *
+ * Statistics are collected only if library is built with `EMPLOYEE_LIB_STATS` option,
+ * otherwise instrumentation is compiled out and all values are zero.
+ */
+struct EmployeeManagerStats {
+    bool enabled = false; //!< Statistics are collected
+
+    //!< Statistics of every operation
+    std::array<OperationStats, MANAGER_OPERATIONS_COUNT> operations;
+
+    LockStats registry_lock;  //!< Lock of employees registry
+    LockStats hierarchy_lock; //!< Lock of hierarchy (subordination relations)
+
+    //!< Numbers of nodes visited by every walk over hierarchy
+    std::array<Histogram, HIERARCHY_TRAVERSALS_COUNT> nodes_visited;
+
+    /**
+     * @brief Get statistics of operation
+     * @param operation operation
+     * @return operation statistics
+     */
+    const OperationStats& operator[](ManagerOperation operation) const {
+        return operations[static_cast<size_t>(operation)];
+    }
+
+    /**
+     * @brief Get numbers of nodes visited by walk over hierarchy
+     * @param traversal walk over hierarchy
+     * @return histogram of numbers of visited nodes
+     */
+    const Histogram& operator[](HierarchyTraversal traversal) const {
+        return nodes_visited[static_cast<size_t>(traversal)];
+    }
+};
+
+} // namespace employee
@@ -0,0 +1,167 @@
+#pragma once
+
+// boost includes
+#include <boost/uuid/uuid.hpp>
+
+// C++ includes
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// relative includes
+#include "EmployeeDescr.h"
+#include "Month.h"
+#include "PayrollByType.h"
+#include "SalaryPolicy.h"
+
+namespace employee
+{
+
+/**
+ * @class EmployeeRegistryView
+ * @brief Class that provides a read-only API over registry file written by
+ * `EmployeeManager::save`
+ *
+ * File is memory-mapped and queries are served directly from the mapping without any
+ * deserialization, so opening is cheap and pages of the file are shared by all processes that
+ * open it. The file must not be modified while it is opened (`EmployeeManager::save` never
+ * modifies existing file, it replaces it by a new one).
+ *
+ * All methods are thread-safe; queries run concurrently with `open` see either previous or new
+ * registry.
+ */
+class EmployeeRegistryView {
+public:
+    EmployeeRegistryView(const EmployeeRegistryView& other)  = delete;
+    EmployeeRegistryView(const EmployeeRegistryView&& other) = delete;
+
+    EmployeeRegistryView& operator=(const EmployeeRegistryView& other)  = delete;
+    EmployeeRegistryView& operator=(const EmployeeRegistryView&& other) = delete;
+
+    /**
+     * @brief Construct an EmployeeRegistryView object (without opened registry)
+     */
+    EmployeeRegistryView();
+
+    /**
+     * @brief Construct an EmployeeRegistryView object with specific salary policy (without
+     * opened registry)
+     * @param salary_policy salary policy of salary calculations
+     */
+    explicit EmployeeRegistryView(const SalaryPolicy& salary_policy);
+
+    /**
+     * @brief Destruct an EmployeeRegistryView object
+     */
+    ~EmployeeRegistryView();
+
+    /**
+     * @brief Open registry file (previously opened one is closed on success)
+     * The whole file structure is validated once on opening.
+     * @param path file path
+     * @return success status
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Get number of employees (0 if registry is not opened)
+     */
+    size_t size() const;
+
+    /**
+     * @brief Find employee by it unique identifier
+     * @param id unique employee identifier
+     * @return optional value of employee description
+     */
+    std::optional<EmployeeDescr> find_employee(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get employee chief
+     * @param id employee unique identifier
+     * @return chief unique identifier (optional value)
+     */
+    std::optional<boost::uuids::uuid> get_chief(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Check if employee is direct or indirect subordinate of chief
+     * @param chief chief unique identifier
+     * @param id employee unique identifier
+     * @return is subordinate or not
+     */
+    bool is_subordinate(const boost::uuids::uuid& chief, const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get employee direct subordinates
+     * @param id employee unique identifier
+     * @return direct subordinates
+     */
+    std::vector<boost::uuids::uuid> get_direct_subordinates(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get employee all subordinates (in pre-order)
+     * @param id employee unique identifier
+     * @return all subordinates
+     */
+    std::vector<boost::uuids::uuid> get_all_subordinates(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Count employee all subordinates (without subordinates traversal)
+     * @param id employee unique identifier
+     * @return number of all subordinates
+     */
+    size_t count_all_subordinates(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Calculate employee salary
+     * @param id employee unique identifier
+     * @param date date
+     * @return month salary and success flag
+     */
+    std::pair<double, bool> calculate_employee_salary(const boost::uuids::uuid& id,
+                                                      const date_t&             date) const;
+
+    /**
+     * @brief Calculate employee salary (month given by ordinal, see `to_month`)
+     * @param id employee unique identifier
+     * @param month month ordinal
+     * @return month salary and success flag
+     */
+    std::pair<double, bool> calculate_employee_salary(const boost::uuids::uuid& id,
+                                                      month_t                   month) const;
+
+    /**
+     * @brief Calculate total salary of all employees (whole-company payroll)
+     * @param date date
+     * @return total month salary and success flag
+     */
+    std::pair<double, bool> calculate_total_payroll(const date_t& date) const;
+
+    /**
+     * @brief Calculate total salary of all employees (month given by ordinal, see `to_month`)
+     * @param month month ordinal
+     * @return total month salary and success flag
+     */
+    std::pair<double, bool> calculate_total_payroll(month_t month) const;
+
+    /**
+     * @brief Calculate total salary and headcount of every employee category
+     * @param date date
+     * @return payroll of every category and success flag
+     */
+    std::pair<PayrollByType, bool> calculate_payroll_by_type(const date_t& date) const;
+
+    /**
+     * @brief Calculate total salary and headcount of every employee category (month given by
+     * ordinal, see `to_month`)
+     * @param month month ordinal
+     * @return payroll of every category and success flag
+     */
+    std::pair<PayrollByType, bool> calculate_payroll_by_type(month_t month) const;
+
+private:
+    class PrivateData;
+    std::unique_ptr<PrivateData> p_data_;
+};
+
+} // namespace employee
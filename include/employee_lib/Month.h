@@ -0,0 +1,61 @@
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+// relative includes
+#include "EmployeeDescr.h"
+
+namespace employee
+{
+
+//!< Month ordinal: 12 * year + (month - 1), i.e. number of months since the beginning of the era
+using month_t = int32_t;
+
+/**
+ * @brief Get month ordinal of date (day value is ignored)
+ * @param date date
+ * @return number of months since the beginning of the era
+ */
+inline month_t to_month(const date_t& date) {
+    return 12 * static_cast<month_t>(date.year()) + (static_cast<month_t>(date.month()) - 1);
+}
+
+/**
+ * @brief Get the first day of month by month ordinal
+ * @param month month ordinal
+ * @return date
+ */
+inline date_t to_date(month_t month) {
+    return date_t(static_cast<unsigned short>(month / 12),
+                  static_cast<unsigned short>(month % 12 + 1), 1);
+}
+
+/**
+ * @brief Check if date with month ordinal and day of month exists (and is representable)
+ * @param month month ordinal
+ * @param day day of month
+ * @return check result
+ */
+inline bool is_valid_date(month_t month, unsigned day) {
+    static const month_t min_month = to_month(date_t{boost::gregorian::min_date_time});
+    static const month_t max_month = to_month(date_t{boost::gregorian::max_date_time});
+
+    return month >= min_month && month <= max_month && day >= 1 &&
+           day <= boost::gregorian::gregorian_calendar::end_of_month_day(
+                      static_cast<unsigned short>(month / 12),
+                      static_cast<unsigned short>(month % 12 + 1));
+}
+
+/**
+ * @brief Get date by month ordinal and day of month
+ * @param month month ordinal
+ * @param day day of month (must exist in month, see `is_valid_date`)
+ * @return date
+ */
+inline date_t to_date(month_t month, unsigned day) {
+    return date_t(static_cast<unsigned short>(month / 12),
+                  static_cast<unsigned short>(month % 12 + 1), static_cast<unsigned short>(day));
+}
+
+} // namespace employee
@@ -0,0 +1,51 @@
+#pragma once
+
+// C++ includes
+#include <array>
+#include <cstddef>
+
+// relative includes
+#include "EmployeeDescr.h"
+
+namespace employee
+{
+
+//!< Number of employee categories
+constexpr size_t EMPLOYEE_TYPES_COUNT = 3;
+
+/**
+ * @class CategoryPayroll
+ * @brief Class that describes month payroll of one employee category
+ */
+struct CategoryPayroll {
+    double total     = 0.0; //!< Total month salary of all employees of category
+    size_t headcount = 0;   //!< Number of employees of category
+};
+
+/**
+ * @class PayrollByType
+ * @brief Class that describes month payroll broken down by employee categories
+ */
+struct PayrollByType {
+    std::array<CategoryPayroll, EMPLOYEE_TYPES_COUNT> categories; //!< Payroll of every category
+
+    /**
+     * @brief Get payroll of employee category
+     * @param type employee category
+     * @return category payroll
+     */
+    CategoryPayroll& operator[](EmployeeType type) {
+        return categories[static_cast<size_t>(type)];
+    }
+
+    /**
+     * @brief Get payroll of employee category
+     * @param type employee category
+     * @return category payroll
+     */
+    const CategoryPayroll& operator[](EmployeeType type) const {
+        return categories[static_cast<size_t>(type)];
+    }
+};
+
+} // namespace employee
@@ -0,0 +1,78 @@
+#pragma once
+
+// C++ includes
+#include <array>
+#include <optional>
+#include <string>
+
+// relative includes
+#include "EmployeeDescr.h"
+#include "PayrollByType.h"
+
+namespace employee
+{
+
+/**
+ * @class CategoryRules
+ * @brief Class that describes salary rules of employee category
+ *
+ * Month salary of employee is
+ * `base * (1 + min(seniority_cap, seniority_rate * full_years))`
+ * `+ direct_bonus_rate * (total salary of direct subordinates)`
+ * `+ all_bonus_rate * (total salary of all subordinates)`.
+ * Salary is calculated only if employee is hired and so are the subordinates his bonuses depend
+ * on (bonus with zero rate does not depend on them).
+ */
+struct CategoryRules {
+    double seniority_rate    = 0.0; //!< Bonus rate for every full year of service
+    double seniority_cap     = 0.0; //!< Bonus cap (rate of base salary)
+    double direct_bonus_rate = 0.0; //!< Bonus rate of total salary of direct subordinates
+    double all_bonus_rate    = 0.0; //!< Bonus rate of total salary of all subordinates
+};
+
+/**
+ * @class SalaryPolicy
+ * @brief Class that describes salary rules of every employee category (flat coefficients table)
+ */
+struct SalaryPolicy {
+    std::array<CategoryRules, EMPLOYEE_TYPES_COUNT> rules; //!< Rules of every category
+
+    /**
+     * @brief Get rules of employee category
+     * @param type employee category
+     * @return category rules
+     */
+    constexpr CategoryRules& operator[](EmployeeType type) {
+        return rules[static_cast<size_t>(type)];
+    }
+
+    /**
+     * @brief Get rules of employee category
+     * @param type employee category
+     * @return category rules
+     */
+    constexpr const CategoryRules& operator[](EmployeeType type) const {
+        return rules[static_cast<size_t>(type)];
+    }
+};
+
+//!< Built-in salary policy (used unless other one is given by `EmployeeManagerConfig`)
+constexpr SalaryPolicy DEFAULT_SALARY_POLICY{{{
+    {0.1, 1.0, 0.0, 0.0},   // WORKER: 10% per year up to 100%
+    {0.05, 0.4, 0.07, 0.0}, // FOREMAN: 5% per year up to 40%, 7% of direct subordinates
+    {0.0, 0.0, 0.0, 0.03}   // MANAGER: 3% of all subordinates
+}}};
+
+/**
+ * @brief Parse salary policy from text (e.g. per-tenant settings loaded at runtime)
+ *
+ * Every non-empty line that is not a comment (starts with `#`) holds rules of one category:
+ * `<worker|foreman|manager> <seniority_rate> <seniority_cap> <direct_bonus_rate>
+ * <all_bonus_rate>`. Categories that are not listed keep rules of the built-in policy.
+ *
+ * @param text policy text
+ * @return policy (nullopt if text is malformed or any coefficient is negative or not finite)
+ */
+std::optional<SalaryPolicy> parse_salary_policy(const std::string& text);
+
+} // namespace employee
@@ -0,0 +1,248 @@
+// relative includes
+#include "ChangeJournal.h"
+#include "DurableFile.h"
+
+// C++ includes
+#include <cstring>
+#include <fstream>
+
+// system includes
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace employee;
+
+namespace
+{
+
+//! Calculate checksum of record (FNV-1a over all fields before checksum)
+uint64_t record_checksum(const JournalRecord& record) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < offsetof(JournalRecord, checksum); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+//! Check if record is complete and not damaged
+bool is_valid_record(const JournalRecord& record) {
+    const uint32_t operation = static_cast<uint32_t>(record.operation);
+
+    return operation >= static_cast<uint32_t>(JournalOperation::ADD_EMPLOYEE) &&
+           operation <= static_cast<uint32_t>(JournalOperation::REMOVE_SUBORDINATION) &&
+           record.checksum == record_checksum(record) &&
+           (record.operation != JournalOperation::ADD_EMPLOYEE ||
+            is_valid_date(record.hire_month, record.hire_day));
+}
+
+} // namespace
+
+//! Read change journal file
+std::optional<JournalImage> employee::read_journal_file(const std::string& path) {
+    // 1.Whole file by a single read
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    const std::streamoff size = file.tellg();
+    if (size < static_cast<std::streamoff>(sizeof(JournalFileHeader))) {
+        return std::nullopt;
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(size));
+
+    file.seekg(0);
+    if (!file.read(buffer.data(), size)) {
+        return std::nullopt;
+    }
+
+    // 2.Validate header
+    JournalFileHeader header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, JOURNAL_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.format_version != JOURNAL_FILE_VERSION ||
+        header.byte_order_mark != JOURNAL_FILE_BYTE_ORDER_MARK) {
+        return std::nullopt;
+    }
+
+    // 3.Records up to the first torn one
+    JournalImage image;
+    image.generation = header.generation;
+
+    const size_t count = (buffer.size() - sizeof(header)) / sizeof(JournalRecord);
+    image.records.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        JournalRecord record;
+        std::memcpy(&record, buffer.data() + sizeof(header) + i * sizeof(record), sizeof(record));
+
+        if (!is_valid_record(record)) {
+            break;
+        }
+        image.records.push_back(record);
+    }
+
+    return image;
+}
+
+//! Construct journal and start background thread
+ChangeJournal::ChangeJournal(std::chrono::milliseconds flush_interval,
+                             size_t                    compaction_threshold,
+                             Compaction                compaction) :
+    flush_interval_(flush_interval),
+    compaction_threshold_(compaction_threshold),
+    compaction_(std::move(compaction)),
+    thread_(&ChangeJournal::run, this) {}
+
+//! Close journal and destruct it
+ChangeJournal::~ChangeJournal() {
+    close();
+}
+
+//! Switch journal to new file
+bool ChangeJournal::start(const std::string& path, uint64_t generation) {
+    std::lock_guard<std::mutex> file_lock(file_mtx_);
+
+    // 1.Records of previous file
+    if (fd_ >= 0) {
+        sync_buffer();
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    // 2.New file with header (it must exist after crash, so its directory is synced too)
+    // Pay attention: existing file is never opened, so records of other journal can't be erased
+    failed_ = true;
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    JournalFileHeader header{};
+    std::memcpy(header.magic, JOURNAL_FILE_MAGIC, sizeof(header.magic));
+    header.format_version  = JOURNAL_FILE_VERSION;
+    header.byte_order_mark = JOURNAL_FILE_BYTE_ORDER_MARK;
+    header.generation      = generation;
+
+    if (!write_all(fd, &header, sizeof(header)) || ::fsync(fd) != 0 ||
+        !sync_parent_directory(path)) {
+        ::close(fd);
+        return false;
+    }
+
+    fd_     = fd;
+    failed_ = false;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    file_records_ = 0;
+
+    return true;
+}
+
+//! Append record
+void ChangeJournal::append(JournalRecord record) {
+    record.checksum = record_checksum(record);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    buffer_.push_back(record);
+    ++appended_;
+    ++file_records_;
+}
+
+//! Check if journal is failed
+bool ChangeJournal::is_failed() const {
+    return failed_;
+}
+
+//! Write and sync all records appended before the call
+bool ChangeJournal::flush() {
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        target = appended_;
+    }
+
+    std::lock_guard<std::mutex> file_lock(file_mtx_);
+
+    // Pay attention: records may be already synced by concurrent flush (group commit)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (durable_ >= target) {
+            return !failed_;
+        }
+    }
+
+    return sync_buffer();
+}
+
+//! Stop background thread and flush the rest of records
+void ChangeJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (stop_) {
+            return;
+        }
+        stop_ = true;
+    }
+    cv_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    flush();
+
+    std::lock_guard<std::mutex> file_lock(file_mtx_);
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+//! Background writing loop
+void ChangeJournal::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (!cv_.wait_for(lock, flush_interval_, [this]() -> bool { return stop_; })) {
+        lock.unlock();
+        flush();
+        lock.lock();
+
+        // Pay attention: compaction switches journal to new file, so it is called without locks
+        if (compaction_threshold_ > 0 && file_records_ >= compaction_threshold_ && !stop_) {
+            lock.unlock();
+            compaction_();
+            lock.lock();
+        }
+    }
+}
+
+//! Write and sync buffered records
+bool ChangeJournal::sync_buffer() {
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        writing_.swap(buffer_);
+        target = appended_;
+    }
+
+    if (!writing_.empty()) {
+        if (fd_ < 0 || !write_all(fd_, writing_.data(), writing_.size() * sizeof(JournalRecord)) ||
+            ::fdatasync(fd_) != 0) {
+            failed_ = true;
+        }
+        writing_.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    durable_ = target;
+
+    return !failed_;
+}
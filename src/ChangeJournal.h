@@ -0,0 +1,203 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+#include <employee_lib/Month.h>
+
+// boost includes
+#include <boost/uuid/uuid.hpp>
+
+// C++ includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class JournalOperation
+ * @brief Class that enumerates changes written to change journal
+ */
+enum class JournalOperation : uint32_t {
+    ADD_EMPLOYEE = 1,    //!< Employee `first` was registered (with type, salary and hire date)
+    REMOVE_EMPLOYEE,     //!< Employee `first` was removed
+    ADD_SUBORDINATION,   //!< Relation "first-->second" was added
+    REMOVE_SUBORDINATION //!< Relation "first-->second" was removed
+};
+
+/**
+ * @struct JournalRecord
+ * @brief Record of change journal (fixed size, protected by checksum, so torn record at the end
+ * of journal is detected)
+ */
+struct JournalRecord {
+    JournalOperation   operation;   //!< Change
+    EmployeeType       type;        //!< Category (`ADD_EMPLOYEE` only)
+    double             base_salary; //!< Base salary (`ADD_EMPLOYEE` only)
+    month_t            hire_month;  //!< Hire month (`ADD_EMPLOYEE` only)
+    uint32_t           hire_day;    //!< Day of hire date (`ADD_EMPLOYEE` only)
+    boost::uuids::uuid first;       //!< Employee or chief unique identifier
+    boost::uuids::uuid second;      //!< Subordinate unique identifier (relations only)
+    uint64_t           checksum;    //!< Checksum of all previous fields
+};
+
+static_assert(sizeof(JournalRecord) == 64, "Journal record must have no padding");
+
+/**
+ * @struct JournalFileHeader
+ * @brief Header of change journal file (followed by records)
+ */
+struct JournalFileHeader {
+    char     magic[8];        //!< File signature (`JOURNAL_FILE_MAGIC`)
+    uint32_t format_version;  //!< Version of file format
+    uint32_t byte_order_mark; //!< `JOURNAL_FILE_BYTE_ORDER_MARK` in byte order of writer
+    uint64_t generation;      //!< Generation of journal (see `ChangeJournal`)
+    uint64_t reserved;        //!< Reserved (zero)
+};
+
+/**
+ * @struct JournalImage
+ * @brief Records read from change journal file
+ */
+struct JournalImage {
+    uint64_t                   generation; //!< Generation of journal
+    std::vector<JournalRecord> records;    //!< Valid records (in order of changes)
+};
+
+//!< Signature of change journal file
+constexpr char JOURNAL_FILE_MAGIC[8] = {'E', 'M', 'P', 'L', 'J', 'R', 'N', '\0'};
+
+//!< Version of change journal file format
+constexpr uint32_t JOURNAL_FILE_VERSION = 1;
+
+//!< Byte order mark of change journal file
+constexpr uint32_t JOURNAL_FILE_BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * @brief Read change journal file
+ * Records are read up to the end of file or up to the first torn (incomplete or damaged) record,
+ * which is the trace of crash during writing
+ * @param path file path
+ * @return generation and records (nullopt if file can't be read or has invalid header)
+ */
+std::optional<JournalImage> read_journal_file(const std::string& path);
+
+/**
+ * @class ChangeJournal
+ * @brief Class of append-only change journal with group commit
+ *
+ * Records are appended to memory buffer (no system call per change) and buffer is written and
+ * synced to disk by background thread every flush interval or by explicit `flush`, so a single
+ * sync makes durable all changes appended since the previous one. Concurrent `flush` callers
+ * share the same sync.
+ *
+ * Every journal file has a generation: registry file written by compaction stores generation of
+ * the journal started at the same moment, so journals of older generations are already included
+ * in registry file (and are removed only after it is synced).
+ */
+class ChangeJournal {
+public:
+    //!< Compaction requested by background thread when journal becomes long
+    using Compaction = std::function<void()>;
+
+    ChangeJournal() = delete;
+
+    ChangeJournal(const ChangeJournal& other)  = delete;
+    ChangeJournal(const ChangeJournal&& other) = delete;
+
+    ChangeJournal& operator=(const ChangeJournal& other)  = delete;
+    ChangeJournal& operator=(const ChangeJournal&& other) = delete;
+
+    /**
+     * @brief Construct journal (without file) and start background thread
+     * @param flush_interval interval of background writing
+     * @param compaction_threshold number of records of journal file after which compaction is
+     * requested (0 for no requests)
+     * @param compaction compaction called by background thread
+     */
+    ChangeJournal(std::chrono::milliseconds flush_interval,
+                  size_t                    compaction_threshold,
+                  Compaction                compaction);
+
+    /**
+     * @brief Close journal and destruct it
+     */
+    ~ChangeJournal();
+
+    /**
+     * @brief Switch journal to new file (appended records are made durable in previous file
+     * first)
+     * @param path path of new file (fails if file exists)
+     * @param generation generation of new file
+     * @return success status
+     */
+    bool start(const std::string& path, uint64_t generation);
+
+    /**
+     * @brief Append record (it is made durable by the next flush)
+     * @param record record (checksum is calculated here)
+     */
+    void append(JournalRecord record);
+
+    /**
+     * @brief Check if journal is failed (file can't be started or written, so appended records
+     * may be lost until journal is switched to new file successfully)
+     * @return failure status
+     */
+    bool is_failed() const;
+
+    /**
+     * @brief Write and sync all records appended before the call
+     * @return success status (false if any write to current file failed)
+     */
+    bool flush();
+
+    /**
+     * @brief Stop background thread and flush the rest of records (journal must not be used
+     * after that)
+     */
+    void close();
+
+private:
+    /**
+     * @brief Background writing loop
+     */
+    void run();
+
+    /**
+     * @brief Write and sync buffered records
+     * Attention! Lock of `file_mtx_` must be held by the caller
+     * @return success status (false if any write to current file failed)
+     */
+    bool sync_buffer();
+
+    std::chrono::milliseconds flush_interval_;       //!< Interval of background writing
+    size_t                    compaction_threshold_; //!< Records number to request compaction
+    Compaction                compaction_;           //!< Compaction called by background thread
+
+    std::mutex                 file_mtx_;      //!< Serializes writing and switching of files
+    std::vector<JournalRecord> writing_;       //!< Records being written
+    int                        fd_ = -1;       //!< Descriptor of current file
+    std::atomic<bool>          failed_{false}; //!< Starting or writing of current file failed
+
+    std::mutex                 mtx_;                  //!< Protects buffer, counters, stop flag
+    std::condition_variable    cv_;                   //!< Wakes background thread on stop
+    std::vector<JournalRecord> buffer_;               //!< Appended records not written yet
+    uint64_t                   appended_     = 0;     //!< Number of appended records
+    uint64_t                   durable_      = 0;     //!< Number of synced records
+    size_t                     file_records_ = 0;     //!< Number of records of current file
+    bool                       stop_         = false; //!< Background thread must stop
+
+    std::thread thread_; //!< Background thread
+};
+
+} // namespace employee
@@ -0,0 +1,74 @@
+// relative includes
+#include "DurableFile.h"
+
+// C++ includes
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+
+// system includes
+#include <fcntl.h>
+#include <unistd.h>
+
+//! Write the whole data to file descriptor
+bool employee::write_all(int fd, const void* data, size_t size) {
+    const char* current = static_cast<const char*>(data);
+
+    while (size > 0) {
+        const ssize_t written = ::write(fd, current, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        current += written;
+        size -= static_cast<size_t>(written);
+    }
+
+    return true;
+}
+
+//! Sync directory of file
+bool employee::sync_parent_directory(const std::string& path) {
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+
+    return ok;
+}
+
+//! Replace file by new content durably
+bool employee::replace_file(const std::string& path, const void* data, size_t size) {
+    // 1.Temporary file
+    const std::string temp_path = path + ".tmp";
+
+    const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool written = write_all(fd, data, size) && ::fsync(fd) == 0;
+    if (::close(fd) != 0 || !written) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    // 2.Replace target file by it
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    return sync_parent_directory(path);
+}
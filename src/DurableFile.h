@@ -0,0 +1,37 @@
+#pragma once
+
+// C++ includes
+#include <cstddef>
+#include <string>
+
+namespace employee
+{
+
+/**
+ * @brief Write the whole data to file descriptor (partial and interrupted writes are continued)
+ * @param fd file descriptor
+ * @param data data
+ * @param size size of data
+ * @return success status
+ */
+bool write_all(int fd, const void* data, size_t size);
+
+/**
+ * @brief Sync directory of file, so creation or renaming of the file survives crash
+ * @param path file path
+ * @return success status
+ */
+bool sync_parent_directory(const std::string& path);
+
+/**
+ * @brief Replace file by new content durably
+ * Content is written and synced to temporary file, which then replaces target file, so target
+ * file is never left half-written (after crash it has either previous or new content)
+ * @param path file path
+ * @param data content
+ * @param size size of content
+ * @return success status
+ */
+bool replace_file(const std::string& path, const void* data, size_t size);
+
+} // namespace employee
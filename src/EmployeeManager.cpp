@@ -3,159 +3,824 @@
 
 // boost includes
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 // relative includes
-#include "Employee.h"
+#include "ChangeJournal.h"
+#include "DurableFile.h"
+#include "IdGenerator.h"
+#include "RegistryFile.h"
+#include "RegistryVersion.h"
 #include "RelationManager.h"
 #include "SalaryCalculator.h"
+#include "SalaryRequests.h"
+#include "ShardedEmployeeStorage.h"
+#include "Snapshot.h"
+#include "Stats.h"
+#include "ThreadPool.h"
 
 // С++ includes
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
 #include <mutex>
+#include <shared_mutex>
 
 using namespace employee;
 
+namespace
+{
+
+//! Make journal record of registration of employee
+JournalRecord make_record(const uuid_t& id, const EmployeeDescr& description) {
+    JournalRecord record{};
+    record.operation   = JournalOperation::ADD_EMPLOYEE;
+    record.type        = description.type;
+    record.base_salary = description.base_salary;
+    record.hire_month  = to_month(description.hire_date);
+    record.hire_day    = description.hire_date.day();
+    record.first       = id;
+
+    return record;
+}
+
+//! Make registry record of new employee (without relations)
+RegistryVersion::Record make_registry_record(const EmployeeDescr& description) {
+    RegistryVersion::Record record;
+    record.type        = description.type;
+    record.base_salary = description.base_salary;
+    record.hire_month  = to_month(description.hire_date);
+    record.hire_day    = static_cast<uint8_t>(description.hire_date.day());
+
+    return record;
+}
+
+//! Make journal record of change of employee or relation
+JournalRecord make_record(JournalOperation operation,
+                          const uuid_t&    first,
+                          const uuid_t&    second = uuid_t{}) {
+    JournalRecord record{};
+    record.operation = operation;
+    record.first     = first;
+    record.second    = second;
+
+    return record;
+}
+
+//! Replay journal records by public API (consecutive registrations and relations additions are
+//! replayed by batches, which accept the same changes as one-by-one calls)
+bool replay_records(EmployeeManager& manager, const std::vector<JournalRecord>& records) {
+    size_t i = 0;
+    while (i < records.size()) {
+        const JournalOperation operation = records[i].operation;
+
+        size_t end = i + 1;
+        if (operation == JournalOperation::ADD_EMPLOYEE ||
+            operation == JournalOperation::ADD_SUBORDINATION) {
+            while (end < records.size() && records[end].operation == operation) {
+                ++end;
+            }
+        }
+
+        bool ok = false;
+        switch (operation) {
+        case JournalOperation::ADD_EMPLOYEE: {
+            std::vector<uuid_t>        ids;
+            std::vector<EmployeeDescr> descriptions;
+            for (size_t k = i; k < end; ++k) {
+                ids.push_back(records[k].first);
+                descriptions.push_back({records[k].type, records[k].base_salary,
+                                        to_date(records[k].hire_month, records[k].hire_day)});
+            }
+            ok = manager.add_employees(ids, descriptions);
+            break;
+        }
+        case JournalOperation::REMOVE_EMPLOYEE:
+            ok = manager.remove_employee(records[i].first);
+            break;
+        case JournalOperation::ADD_SUBORDINATION: {
+            std::vector<std::pair<uuid_t, uuid_t>> relations;
+            for (size_t k = i; k < end; ++k) {
+                relations.emplace_back(records[k].first, records[k].second);
+            }
+            ok = manager.add_subordinations(relations);
+            break;
+        }
+        case JournalOperation::REMOVE_SUBORDINATION:
+            ok = manager.remove_subordination(records[i].first, records[i].second);
+            break;
+        }
+
+        if (!ok) {
+            return false;
+        }
+        i = end;
+    }
+
+    return true;
+}
+
+//! Get path of change journal file of generation (every generation has its own file, so no
+//! journal file is ever rewritten)
+std::string journal_file_path(const std::string& journal_path, uint64_t generation) {
+    return journal_path + "." + std::to_string(generation);
+}
+
+//! Find change journal files by their generations (in order of generations)
+std::vector<std::pair<uint64_t, std::string>> find_journal_files(const std::string& journal_path) {
+    const std::filesystem::path path = journal_path;
+    const std::string           prefix = path.filename().string() + ".";
+
+    std::filesystem::path directory = path.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> files;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end;
+         it.increment(error)) {
+        const std::string name = it->path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+            !std::all_of(name.begin() + prefix.size(), name.end(),
+                         [](char c) -> bool { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+
+        files.emplace_back(std::stoull(name.substr(prefix.size())), it->path().string());
+    }
+    std::sort(files.begin(), files.end());
+
+    return files;
+}
+
+} // namespace
+
 class EmployeeManager::PrivateData {
 public:
-    PrivateData() :
-        employees(boost::unordered_map<uuid_t, Employee*>{}), relation_manager(RelationManager{}),
-        salary_calculator(SalaryCalculator{employees, relation_manager}) {}
+    explicit PrivateData(const EmployeeManagerConfig& config) :
+        config(config),
+        employees(config.storage_shards, config.memory_resource),
+        pool(config.worker_threads > 0 ? std::make_unique<ThreadPool>(config.worker_threads)
+                                       : nullptr),
+        salary_calculator(pool.get(), config.salary_policy) {}
+
+    ~PrivateData() {
+        // Queued asynchronous calculations are completed while other members are alive
+        salary_requests.reset();
+
+        // Pay attention: background thread of journal may run compaction over other members, so
+        // it is stopped first
+        if (journal != nullptr) {
+            journal->close();
+        }
+    }
 
     template<typename... Args>
-    std::array<Employee*, sizeof...(Args)> find_employees_by_ids(Args... args) {
+    std::array<std::optional<EmployeeType>, sizeof...(Args)> find_types_by_ids(Args... args) {
         static_assert((std::is_same_v<Args, uuid_t> && ...),
                       "All arguments must be boost::uuids::uuid");
 
-        std::array<Employee*, sizeof...(Args)> result{};
+        std::array<std::optional<EmployeeType>, sizeof...(Args)> result{};
 
         size_t i = 0;
-        ((result[i++] = (employees.find(args) != employees.end()) ? employees.at(args) : nullptr),
-         ...);
+        ((result[i++] = employees.find_type(args)), ...);
 
         return result;
     }
 
+    //! Drop memoized salaries of employee and all his chiefs before publication of changed
+    //! registry version (caller must hold unique lock of `mtx`, so the next version is his one)
+    void invalidate_salaries(const uuid_t& id) {
+        std::vector<uuid_t> affected = relation_manager.get_all_chiefs(id);
+        affected.push_back(id);
+
+        salary_calculator.invalidate(affected, version.load() + 1);
+    }
+
+    //! Drop memoized salaries of employees and all their chiefs before publication of changed
+    //! registry version (caller must hold unique lock of `mtx`, so the next version is his one)
+    void invalidate_salaries(const std::vector<uuid_t>& ids) {
+        salary_calculator.invalidate(relation_manager.get_all_chiefs(ids), version.load() + 1);
+    }
+
+    //! Publish new registry version made by change of the last one (caller must hold unique lock
+    //! of `mtx` or shared one together with unique lock of shard of the changed employee)
+    template<typename Change>
+    uint64_t publish(Change&& change) {
+        std::lock_guard<std::mutex> lock(registry_mtx);
+
+        RegistryVersion::Editor editor(*registry);
+        change(editor);
+
+        // Pay attention: memoized salaries are invalidated by the caller before publication, so
+        // readers of new version never take entries calculated by older one
+        const uint64_t new_version = version.load() + 1;
+
+        std::atomic_store(&registry, editor.publish(new_version));
+        version = new_version;
+
+        return new_version;
+    }
+
+    //! Refresh relations and subtree sizes of employees in edited registry version by hierarchy
+    void refresh_relations(RegistryVersion::Editor& editor, const std::vector<uuid_t>& ids) {
+        for (const uuid_t& id : ids) {
+            const RegistryVersion::Record* p_record = editor.find(id);
+            if (p_record == nullptr) {
+                continue;
+            }
+
+            RegistryVersion::Record record = *p_record;
+            record.chief        = relation_manager.get_chief(id).value_or(uuid_t{});
+            record.subtree_size = static_cast<uint32_t>(relation_manager.subtree_size(id));
+
+            std::vector<uuid_t> subordinates = relation_manager.get_direct_subordinates(id);
+            record.subordinates =
+                subordinates.empty()
+                    ? nullptr
+                    : std::make_shared<const std::vector<uuid_t>>(std::move(subordinates));
+
+            editor.put(id, record);
+        }
+    }
+
+    //! Refresh subtree sizes of employees in edited registry version by hierarchy
+    void refresh_subtree_sizes(RegistryVersion::Editor& editor, const std::vector<uuid_t>& ids) {
+        for (const uuid_t& id : ids) {
+            const RegistryVersion::Record* p_record = editor.find(id);
+            if (p_record == nullptr) {
+                continue;
+            }
+
+            RegistryVersion::Record record = *p_record;
+            record.subtree_size = static_cast<uint32_t>(relation_manager.subtree_size(id));
+
+            editor.put(id, record);
+        }
+    }
+
+    //! Publish registry version with changed relation between chief and subordinate (subtree
+    //! sizes of all chiefs of chief are refreshed too)
+    void publish_relation_change(const uuid_t& chief, const uuid_t& subordinate) {
+        publish([&](RegistryVersion::Editor& editor) {
+            refresh_relations(editor, {chief, subordinate});
+            refresh_subtree_sizes(editor, relation_manager.get_all_chiefs(chief));
+        });
+    }
+
+    //! Get snapshot of actual registry version (rebuild it if registry was changed since last one)
+    std::shared_ptr<const Snapshot> pin_snapshot() {
+        // Pay attention: snapshot is built from published registry version, so no lock of data is
+        // held during rebuild and writers are not blocked
+        const std::shared_ptr<const RegistryVersion> current_registry = std::atomic_load(&registry);
+
+        std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot);
+        if (current != nullptr && current->version() >= current_registry->version()) {
+            return current;
+        }
+
+        // Only one thread rebuilds, others wait and take its result
+        std::lock_guard<std::mutex> rebuild_lock(snapshot_mtx);
+
+        current = std::atomic_load(&snapshot);
+        if (current != nullptr && current->version() >= current_registry->version()) {
+            return current;
+        }
+
+        current = std::make_shared<const Snapshot>(*current_registry);
+        std::atomic_store(&snapshot, current);
+
+        return current;
+    }
+
+    //! Get snapshot if it is of registry version (nullptr if registry was changed since it)
+    std::shared_ptr<const Snapshot> actual_snapshot(const RegistryVersion& current) const {
+        std::shared_ptr<const Snapshot> current_snapshot = std::atomic_load(&snapshot);
+        if (current_snapshot != nullptr && current_snapshot->version() == current.version()) {
+            return current_snapshot;
+        }
+
+        return nullptr;
+    }
+
+    //! Calculate salary of employee over actual snapshot (its index is faster than lookups in trie)
+    //! or, if registry was changed since it, over the last published registry version: salary
+    //! depends on employee subtree only, so one change must not cost copy of the whole registry
+    std::pair<double, bool> calculate_salary(const uuid_t& id, month_t month) {
+        const std::shared_ptr<const RegistryVersion> current = std::atomic_load(&registry);
+
+        if (const std::shared_ptr<const Snapshot> current_snapshot = actual_snapshot(*current);
+            current_snapshot != nullptr) {
+            return salary_calculator.calculate_month_salary(*current_snapshot, id, month);
+        }
+
+        return salary_calculator.calculate_month_salary(*current, id, month);
+    }
+
+    //! Calculate salaries of batch of employees over the same snapshot or registry version (see
+    //! `calculate_salary`)
+    std::vector<std::pair<double, bool>> calculate_salaries(const std::vector<uuid_t>& ids,
+                                                            month_t                    month) {
+        const std::shared_ptr<const RegistryVersion> current          = std::atomic_load(&registry);
+        const std::shared_ptr<const Snapshot>        current_snapshot = actual_snapshot(*current);
+
+        std::vector<std::pair<double, bool>> salaries;
+        salaries.reserve(ids.size());
+
+        for (const uuid_t& id : ids) {
+            salaries.push_back(
+                current_snapshot != nullptr
+                    ? salary_calculator.calculate_month_salary(*current_snapshot, id, month)
+                    : salary_calculator.calculate_month_salary(*current, id, month));
+        }
+
+        return salaries;
+    }
+
+    //! Get asynchronous salary requests (executor is started by the first call)
+    SalaryRequests& async_requests() {
+        std::call_once(salary_requests_once, [this] {
+            salary_requests = std::make_unique<SalaryRequests>(
+                config.async_threads,
+                [this](const std::vector<uuid_t>& ids, month_t month) {
+                    return calculate_salaries(ids, month);
+                });
+        });
+
+        return *salary_requests;
+    }
+
+    //! Get recorder of operation latency
+    HistogramRecorder& operation_stats(ManagerOperation operation) {
+        return operations_stats[static_cast<size_t>(operation)];
+    }
+
+    //! Check if changes are accepted: once journal is failed, changes are rejected until
+    //! compaction starts new journal file, so every change reported as done is journaled
+    bool accepts_changes() const {
+        return journal == nullptr || !journal->is_failed();
+    }
+
+    //! Write change to journal if it is opened (caller must hold unique lock of `mtx` or shared
+    //! one together with unique lock of shard of the employee, so dependent changes are written in
+    //! order of their application)
+    void journal_change(const JournalRecord& record) {
+        if (journal != nullptr) {
+            journal->append(record);
+        }
+    }
+
+    //! Create all employees and hierarchy of registry image at once (registry must be empty)
+    bool load_image(const RegistryImage& image) {
+        const size_t count = image.ids.size();
+
+        TimedUniqueLock lock(mtx, lock_stats);
+
+        if (employees.size() != 0 || journal != nullptr) {
+            return false;
+        }
+
+        employees.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const uuid_t&       id = image.ids[i];
+            const EmployeeDescr description{image.types[i], image.base_salaries[i],
+                                            to_date(image.hire_months[i], image.hire_days[i])};
+
+            // Nil or repeated identifier: roll back already created objects
+            if (id.is_nil() || !employees.emplace(description, id)) {
+                for (size_t j = 0; j < i; ++j) {
+                    employees.erase(image.ids[j]);
+                }
+                return false;
+            }
+        }
+
+        // Registry file is in pre-order, so hierarchy is built without validation by linear scans
+        relation_manager.add_forest(image.ids, image.chiefs);
+
+        // Registry version: subordinates lists in pre-order, subtree sizes by reverse scan
+        std::vector<std::vector<uuid_t>> subordinates(count);
+        std::vector<uint32_t>            subtree_sizes(count, 0);
+
+        for (size_t i = 0; i < count; ++i) {
+            if (image.chiefs[i] != RelationManager::NONE) {
+                subordinates[image.chiefs[i]].push_back(image.ids[i]);
+            }
+        }
+        for (size_t i = count; i > 0; --i) {
+            if (image.chiefs[i - 1] != RelationManager::NONE) {
+                subtree_sizes[image.chiefs[i - 1]] += subtree_sizes[i - 1] + 1;
+            }
+        }
+
+        publish([&](RegistryVersion::Editor& editor) {
+            for (size_t i = 0; i < count; ++i) {
+                RegistryVersion::Record record;
+                record.type         = image.types[i];
+                record.base_salary  = image.base_salaries[i];
+                record.hire_month   = image.hire_months[i];
+                record.hire_day     = image.hire_days[i];
+                record.subtree_size = subtree_sizes[i];
+                if (image.chiefs[i] != RelationManager::NONE) {
+                    record.chief = image.ids[image.chiefs[i]];
+                }
+                if (!subordinates[i].empty()) {
+                    record.subordinates =
+                        std::make_shared<const std::vector<uuid_t>>(std::move(subordinates[i]));
+                }
+
+                editor.put(image.ids[i], record);
+            }
+        });
+
+        return true;
+    }
+
+    //! Compact change journal (caller must hold `journal_mtx`)
+    bool compact_journal() {
+        // 1.Consistent copy of data and switch of journal to file of new generation: all writers
+        // (including registrations under shared lock) are excluded, so every change is either in
+        // the copy or in the new file
+        std::shared_ptr<const Snapshot> copy;
+        uint64_t                        generation = 0;
+        {
+            TimedUniqueLock lock(mtx, lock_stats);
+
+            copy = std::make_shared<const Snapshot>(*std::atomic_load(&registry));
+            generation = ++journal_generation;
+
+            if (!journal->start(journal_file_path(journal_path, generation), generation)) {
+                return false;
+            }
+        }
+
+        // 2.Registry file (changes are not blocked meanwhile)
+        // Pay attention: on failure journals of all generations are kept, so registry file
+        // written by previous compaction and them still hold every change
+        if (!write_registry_file(registry_path, *copy, generation)) {
+            return false;
+        }
+
+        // 3.Registry file and its directory are synced, so journals of older generations are
+        // included into it and not needed anymore
+        for (const auto& [file_generation, path] : find_journal_files(journal_path)) {
+            if (file_generation < generation) {
+                std::remove(path.c_str());
+            }
+        }
+
+        return true;
+    }
+
 public:
-    std::mutex                              mtx;
-    boost::unordered_map<uuid_t, Employee*> employees;
+    EmployeeManagerConfig config; //!< Settings
+
+    std::shared_mutex                       mtx; //!< Shared for readers, unique for writers
+    ShardedEmployeeStorage                  employees; //!< Employees partitioned into shards
+
+    LockRecorder lock_stats; //!< Statistics of `mtx`
+
+    //!< Latencies of every operation
+    std::array<HistogramRecorder, MANAGER_OPERATIONS_COUNT> operations_stats;
 
     RelationManager relation_manager;
 
-    SalaryCalculator salary_calculator;
+    std::unique_ptr<ThreadPool> pool; //!< Workers for parallel calculations (optional)
+    SalaryCalculator            salary_calculator;
+
+    std::mutex            registry_mtx; //!< Serializes publications of registry versions
+    std::atomic<uint64_t> version{0};   //!< Version of the last published registry version
+
+    //!< The last published registry version (atomic access)
+    std::shared_ptr<const RegistryVersion> registry = std::make_shared<const RegistryVersion>();
+
+    std::mutex                      snapshot_mtx; //!< Serializes snapshot rebuilds
+    std::shared_ptr<const Snapshot> snapshot;     //!< Last built snapshot (atomic access)
+
+    std::mutex  journal_mtx;            //!< Serializes opening and compactions of journal
+    std::string registry_path;          //!< Registry file compacted journal is written to
+    std::string journal_path;           //!< Change journal file
+    uint64_t    journal_generation = 0; //!< Generation of actual change journal file
+
+    std::unique_ptr<ChangeJournal> journal; //!< Change journal (optional)
+
+    std::once_flag                  salary_requests_once; //!< Starts asynchronous requests once
+    std::unique_ptr<SalaryRequests> salary_requests;      //!< Asynchronous salary requests
 };
 
 //! Construct an EmployeeManager object
-EmployeeManager::EmployeeManager() : p_data_(std::make_unique<PrivateData>()) {}
+EmployeeManager::EmployeeManager() : EmployeeManager(EmployeeManagerConfig{}) {}
+
+//! Construct an EmployeeManager object with specific settings
+EmployeeManager::EmployeeManager(const EmployeeManagerConfig& config) :
+    p_data_(std::make_unique<PrivateData>(config)) {}
 
 //! Destruct an EmployeeManager object
-EmployeeManager::~EmployeeManager() {
-    for (auto it = p_data_->employees.begin(); it != p_data_->employees.end(); ++it) {
-        delete it->second;
-    }
-    p_data_->employees.clear();
-}
+EmployeeManager::~EmployeeManager() = default;
 
 //! Registrate new employee
 std::pair<uuid_t, bool> EmployeeManager::add_employee(const EmployeeDescr& description) {
-    Employee* employee = Employee::create(description);
-    if (employee == nullptr) {
-        return {uuid_t{}, false};
+    const uuid_t id = generate_id(p_data_->config.id_generator);
+
+    return {id, add_employee(id, description)};
+}
+
+//! Registrate new employee with caller-supplied unique identifier
+bool EmployeeManager::add_employee(const uuid_t& id, const EmployeeDescr& description) {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::ADD_EMPLOYEE));
+
+    if (id.is_nil()) {
+        return false;
     }
 
-    {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
-        p_data_->employees[employee->get_id()] = employee;
+    // Pay attention: new employee has no relations, so hierarchy writers are excluded by shared
+    // lock and registrations of other shards run in parallel
+    TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+
+    ShardedEmployeeStorage::Shard&      shard = p_data_->employees.shard(id);
+    std::unique_lock<std::shared_mutex> shard_lock(shard.mtx);
+
+    if (!p_data_->accepts_changes() ||
+        shard.storage.emplace(description, id) == EmployeeStorage::NONE) {
+        return false;
     }
 
-    return {employee->get_id(), true};
+    p_data_->relation_manager.add_node(id);
+    p_data_->journal_change(make_record(id, description));
+
+    p_data_->publish([&](RegistryVersion::Editor& editor) {
+        editor.put(id, make_registry_record(description));
+    });
+
+    return true;
 }
 
-//! Remove employee from registration list
-bool EmployeeManager::remove_employee(const uuid_t& id) {
-    auto it = p_data_->employees.find(id);
-    if (it == p_data_->employees.end()) {
+//! Registrate many new employees at once
+std::pair<std::vector<uuid_t>, bool>
+EmployeeManager::add_employees(const std::vector<EmployeeDescr>& descriptions) {
+    std::vector<uuid_t> ids;
+    ids.reserve(descriptions.size());
+
+    for (size_t i = 0; i < descriptions.size(); ++i) {
+        ids.push_back(generate_id(p_data_->config.id_generator));
+    }
+
+    if (!add_employees(ids, descriptions)) {
+        return {{}, false};
+    }
+
+    return {std::move(ids), true};
+}
+
+//! Registrate many new employees with caller-supplied unique identifiers at once
+bool EmployeeManager::add_employees(const std::vector<uuid_t>&        ids,
+                                    const std::vector<EmployeeDescr>& descriptions) {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::ADD_EMPLOYEES));
+
+    // 1.Validate identifiers (inside batch)
+    if (ids.size() != descriptions.size()) {
         return false;
     }
 
-    {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
-        delete it->second;
-        p_data_->employees.erase(it);
+    boost::unordered_set<uuid_t> unique_ids(ids.begin(), ids.end());
+    if (unique_ids.size() != ids.size() || unique_ids.count(uuid_t{}) != 0) {
+        return false;
+    }
+
+    // 2.Validate identifiers (against registry) and create all objects at once
+    TimedUniqueLock lock(p_data_->mtx, p_data_->lock_stats);
+
+    if (!p_data_->accepts_changes() ||
+        std::any_of(ids.begin(), ids.end(), [this](const uuid_t& id) -> bool {
+            return p_data_->employees.contains(id);
+        })) {
+        return false;
+    }
+
+    p_data_->employees.reserve(p_data_->employees.size() + ids.size());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        // Unknown category: roll back already created objects
+        if (!p_data_->employees.emplace(descriptions[i], ids[i])) {
+            for (size_t j = 0; j < i; ++j) {
+                p_data_->employees.erase(ids[j]);
+            }
+            return false;
+        }
+    }
+
+    p_data_->relation_manager.add_nodes(ids);
+
+    p_data_->publish([&](RegistryVersion::Editor& editor) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            editor.put(ids[i], make_registry_record(descriptions[i]));
+        }
+    });
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        p_data_->journal_change(make_record(ids[i], descriptions[i]));
     }
 
     return true;
 }
 
-//! Find employee by it unique identifier
-std::optional<EmployeeDescr> EmployeeManager::find_employee(const uuid_t& id) const {
-    const Employee* p_employee = nullptr;
+//! Remove employee from registration list
+bool EmployeeManager::remove_employee(const uuid_t& id) {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::REMOVE_EMPLOYEE));
 
+    // 1.Employee without relations is removed under shared lock (like registration)
     {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
 
-        auto it = p_data_->employees.find(id);
-        if (it == p_data_->employees.end()) {
-            return std::nullopt;
+        ShardedEmployeeStorage::Shard&      shard = p_data_->employees.shard(id);
+        std::unique_lock<std::shared_mutex> shard_lock(shard.mtx);
+
+        if (!p_data_->accepts_changes() || shard.storage.find_slot(id) == EmployeeStorage::NONE) {
+            return false;
         }
 
-        p_employee = it->second;
+        if (p_data_->relation_manager.remove_isolated_node(id)) {
+            p_data_->journal_change(make_record(JournalOperation::REMOVE_EMPLOYEE, id));
+            shard.storage.erase(id);
+
+            // Pay attention: readers of new version do not find the employee, so his salaries are
+            // forgotten after publication (entries of older versions are not memoized anymore)
+            const uint64_t removed_version = p_data_->publish(
+                [&id](RegistryVersion::Editor& editor) { editor.erase(id); });
+
+            p_data_->salary_calculator.forget(id, removed_version);
+            return true;
+        }
+    }
+
+    // 2.Hierarchy is changed too, so the whole registry is locked (and employee is looked up
+    // again: he could be removed meanwhile)
+    TimedUniqueLock lock(p_data_->mtx, p_data_->lock_stats);
+
+    if (!p_data_->accepts_changes() || !p_data_->employees.contains(id)) {
+        return false;
     }
 
-    if (p_employee != nullptr) {
-        EmployeeDescr descr{
-            p_employee->get_type(), p_employee->get_base_salary(), p_employee->get_hire_date()};
-        return descr;
+    // Salaries of all chiefs depend on the employee, so drop them and his relations too
+    p_data_->invalidate_salaries(id);
+    p_data_->salary_calculator.forget(id, p_data_->version.load() + 1);
+
+    const std::vector<uuid_t> chiefs       = p_data_->relation_manager.get_all_chiefs(id);
+    std::vector<uuid_t>       subordinates = p_data_->relation_manager.get_direct_subordinates(id);
+    p_data_->relation_manager.remove_node(id);
+
+    p_data_->journal_change(make_record(JournalOperation::REMOVE_EMPLOYEE, id));
+
+    const bool erased = p_data_->employees.erase(id);
+
+    // Direct chief and subordinates lost relations, subtrees of all chiefs were changed
+    if (!chiefs.empty()) {
+        subordinates.push_back(chiefs.front());
     }
-    return std::nullopt;
+
+    p_data_->publish([&](RegistryVersion::Editor& editor) {
+        editor.erase(id);
+        p_data_->refresh_relations(editor, subordinates);
+        p_data_->refresh_subtree_sizes(editor, chiefs);
+    });
+
+    return erased;
+}
+
+//! Find employee by it unique identifier
+std::optional<EmployeeDescr> EmployeeManager::find_employee(const uuid_t& id) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::FIND_EMPLOYEE));
+
+    // Pay attention: description is copied under lock of shard, so concurrent removal is safe
+    return p_data_->employees.find(id);
 }
 
 //! Add relation between chief and subordinate
 bool EmployeeManager::add_subordination(const uuid_t& chief, const uuid_t& subordinate) {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::ADD_SUBORDINATION));
+
+    // Pay attention: hold lock for the whole operation, so employees storage and hierarchy are
+    // changed consistently (snapshots for salary calculation never see half-done change)
+    TimedUniqueLock lock(p_data_->mtx, p_data_->lock_stats);
+
     // 1.Validate on having such employees and employee category
-    {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
+    const auto [chief_type, subordinate_type] = p_data_->find_types_by_ids(chief, subordinate);
+    if (!chief_type || !subordinate_type || *chief_type == EmployeeType::WORKER ||
+        !p_data_->accepts_changes()) {
+        return false;
+    }
+
+    // 2.Add
+    if (!p_data_->relation_manager.add_relation(chief, subordinate)) {
+        return false;
+    }
+
+    // 3.Subtree of chief (and all his chiefs) was changed
+    p_data_->invalidate_salaries(chief);
+    p_data_->publish_relation_change(chief, subordinate);
+
+    p_data_->journal_change(make_record(JournalOperation::ADD_SUBORDINATION, chief, subordinate));
+
+    return true;
+}
+
+//! Add many relations between chiefs and subordinates at once
+bool EmployeeManager::add_subordinations(const std::vector<std::pair<uuid_t, uuid_t>>& relations) {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::ADD_SUBORDINATIONS));
+
+    // Pay attention: the same lock logic as for `add_subordination`
+    TimedUniqueLock lock(p_data_->mtx, p_data_->lock_stats);
+
+    // 1.Validate on having such employees and employee category
+    if (!p_data_->accepts_changes()) {
+        return false;
+    }
+
+    std::vector<uuid_t> chiefs;
+    chiefs.reserve(relations.size());
 
-        const auto employees = p_data_->find_employees_by_ids(chief, subordinate);
-        if (std::any_of(employees.begin(), employees.end(), [&chief](const Employee* emp) -> bool {
-                return emp == nullptr ||
-                       (emp->get_id() == chief && emp->get_type() == EmployeeType::WORKER);
-            })) {
+    for (const auto& [chief, subordinate] : relations) {
+        const auto [chief_type, subordinate_type] =
+            p_data_->find_types_by_ids(chief, subordinate);
+        if (!chief_type || !subordinate_type || *chief_type == EmployeeType::WORKER) {
             return false;
         }
+        chiefs.push_back(chief);
     }
 
-    // 2.Add
-    return p_data_->relation_manager.add_relation(chief, subordinate);
+    // 2.Add (with validation of the whole batch on hierarchical cycles)
+    if (!p_data_->relation_manager.add_relations(relations)) {
+        return false;
+    }
+
+    // 3.Subtrees of chiefs (and all their chiefs) were changed
+    p_data_->invalidate_salaries(chiefs);
+
+    std::vector<uuid_t> changed = chiefs;
+    for (const auto& [_, subordinate] : relations) {
+        changed.push_back(subordinate);
+    }
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    p_data_->publish([&](RegistryVersion::Editor& editor) {
+        p_data_->refresh_relations(editor, changed);
+        p_data_->refresh_subtree_sizes(editor, p_data_->relation_manager.get_all_chiefs(chiefs));
+    });
+
+    for (const auto& [chief, subordinate] : relations) {
+        p_data_->journal_change(
+            make_record(JournalOperation::ADD_SUBORDINATION, chief, subordinate));
+    }
+
+    return true;
 }
 
 //! Remove subordination relation between chief and subordinate
 bool EmployeeManager::remove_subordination(const uuid_t& chief, const uuid_t& subordinate) {
-    // 1.Validate on having such employees and employee category
-    {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::REMOVE_SUBORDINATION));
 
-        const auto employees = p_data_->find_employees_by_ids(chief, subordinate);
-        if (std::any_of(employees.begin(), employees.end(), [&chief](const Employee* emp) -> bool {
-                return emp == nullptr ||
-                       (emp->get_id() == chief && emp->get_type() == EmployeeType::WORKER);
-            })) {
-            return false;
-        }
+    // Pay attention: hold lock for the whole operation, so employees storage and hierarchy are
+    // changed consistently (snapshots for salary calculation never see half-done change)
+    TimedUniqueLock lock(p_data_->mtx, p_data_->lock_stats);
+
+    // 1.Validate on having such employees and employee category
+    const auto [chief_type, subordinate_type] = p_data_->find_types_by_ids(chief, subordinate);
+    if (!chief_type || !subordinate_type || *chief_type == EmployeeType::WORKER ||
+        !p_data_->accepts_changes()) {
+        return false;
     }
 
     // 2.Remove
-    return p_data_->relation_manager.remove_relation(chief, subordinate);
+    if (!p_data_->relation_manager.remove_relation(chief, subordinate)) {
+        return false;
+    }
+
+    // 3.Subtree of chief (and all his chiefs) was changed
+    p_data_->invalidate_salaries(chief);
+    p_data_->publish_relation_change(chief, subordinate);
+
+    p_data_->journal_change(
+        make_record(JournalOperation::REMOVE_SUBORDINATION, chief, subordinate));
+
+    return true;
 }
 
 //! Get employee chief
 std::optional<uuid_t> EmployeeManager::get_chief(const uuid_t& id) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::GET_CHIEF));
+
     // 1.Validate on having such employee
     {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
 
-        const auto employees = p_data_->find_employees_by_ids(id);
-        if (std::any_of(employees.begin(), employees.end(), [](const Employee* emp) -> bool {
-                return emp == nullptr;
-            })) {
+        const auto types = p_data_->find_types_by_ids(id);
+        if (std::any_of(types.begin(), types.end(),
+                        [](const std::optional<EmployeeType>& type) -> bool { return !type; })) {
             return std::nullopt;
         }
     }
@@ -164,16 +829,36 @@ std::optional<uuid_t> EmployeeManager::get_chief(const uuid_t& id) const {
     return p_data_->relation_manager.get_chief(id);
 }
 
+//! Check if employee is direct or indirect subordinate of chief
+bool EmployeeManager::is_subordinate(const uuid_t& chief, const uuid_t& id) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::IS_SUBORDINATE));
+
+    // 1.Validate on having such employees
+    {
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+
+        const auto types = p_data_->find_types_by_ids(chief, id);
+        if (std::any_of(types.begin(), types.end(),
+                        [](const std::optional<EmployeeType>& type) -> bool { return !type; })) {
+            return false;
+        }
+    }
+
+    // 2.Check by hierarchy numbering
+    return p_data_->relation_manager.is_subordinate(chief, id);
+}
+
 //! Get employee direct subordinates
 std::vector<uuid_t> EmployeeManager::get_direct_subordinates(const uuid_t& id) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::GET_DIRECT_SUBORDINATES));
+
     // 1.Validate on having such employee
     {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
 
-        const auto employees = p_data_->find_employees_by_ids(id);
-        if (std::any_of(employees.begin(), employees.end(), [](const Employee* emp) -> bool {
-                return emp == nullptr;
-            })) {
+        const auto types = p_data_->find_types_by_ids(id);
+        if (std::any_of(types.begin(), types.end(),
+                        [](const std::optional<EmployeeType>& type) -> bool { return !type; })) {
             return {};
         }
     }
@@ -184,14 +869,15 @@ std::vector<uuid_t> EmployeeManager::get_direct_subordinates(const uuid_t& id) c
 
 //! Get employee all subordinates
 std::vector<uuid_t> EmployeeManager::get_all_subordinates(const uuid_t& id) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::GET_ALL_SUBORDINATES));
+
     // 1.Validate on having such employee
     {
-        std::lock_guard<std::mutex> lock(p_data_->mtx);
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
 
-        const auto employees = p_data_->find_employees_by_ids(id);
-        if (std::any_of(employees.begin(), employees.end(), [](const Employee* emp) -> bool {
-                return emp == nullptr;
-            })) {
+        const auto types = p_data_->find_types_by_ids(id);
+        if (std::any_of(types.begin(), types.end(),
+                        [](const std::optional<EmployeeType>& type) -> bool { return !type; })) {
             return {};
         }
     }
@@ -200,23 +886,337 @@ std::vector<uuid_t> EmployeeManager::get_all_subordinates(const uuid_t& id) cons
     return p_data_->relation_manager.get_all_subordinates(id);
 }
 
+//! Visit employee direct subordinates
+bool EmployeeManager::visit_direct_subordinates(const uuid_t&          id,
+                                                const EmployeeVisitor& visitor) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::VISIT_DIRECT_SUBORDINATES));
+
+    // 1.Validate on having such employee
+    {
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+
+        if (!p_data_->employees.contains(id)) {
+            return false;
+        }
+    }
+
+    // 2.Visit
+    p_data_->relation_manager.visit_direct_subordinates(id, visitor);
+    return true;
+}
+
+//! Visit employee all subordinates
+bool EmployeeManager::visit_all_subordinates(const uuid_t&          id,
+                                             const EmployeeVisitor& visitor) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::VISIT_ALL_SUBORDINATES));
+
+    // 1.Validate on having such employee
+    {
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+
+        if (!p_data_->employees.contains(id)) {
+            return false;
+        }
+    }
+
+    // 2.Visit
+    p_data_->relation_manager.visit_all_subordinates(id, visitor);
+    return true;
+}
+
+//! Count all employee subordinates
+size_t EmployeeManager::count_all_subordinates(const uuid_t& id) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::COUNT_ALL_SUBORDINATES));
+
+    // 1.Validate on having such employee
+    {
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+
+        const auto types = p_data_->find_types_by_ids(id);
+        if (std::any_of(types.begin(), types.end(),
+                        [](const std::optional<EmployeeType>& type) -> bool { return !type; })) {
+            return 0;
+        }
+    }
+
+    // 2.Take it from maintained subtree size
+    return p_data_->relation_manager.subtree_size(id);
+}
+
 //! Calculate employee salary
 std::pair<double, bool> EmployeeManager::calculate_employee_salary(const uuid_t& id,
                                                                    const date_t& date) const {
-    // Pay attention: use lock for all function space due to lock employees storage for all
-    // calculation time
-    // TODO: but someone can change relation hierarchy (think about lock logic)
+    return calculate_employee_salary(id, to_month(date));
+}
 
-    // 1.Validate on having such employee
-    std::lock_guard<std::mutex> lock(p_data_->mtx);
+//! Calculate employee salary by month ordinal
+std::pair<double, bool> EmployeeManager::calculate_employee_salary(const uuid_t& id,
+                                                                   month_t       month) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::CALCULATE_EMPLOYEE_SALARY));
 
-    const auto employees = p_data_->find_employees_by_ids(id);
-    if (std::any_of(employees.begin(), employees.end(), [](const Employee* emp) -> bool {
-            return emp == nullptr;
-        })) {
-        return {};
+    // Pay attention: snapshot is not rebuilt for a single employee, so queries mixed with changes
+    // visit only subtree of the employee (whole-registry calculations below pin snapshot: their
+    // cost is the same as cost of its rebuild)
+    return p_data_->calculate_salary(id, month);
+}
+
+//! Calculate employee salary asynchronously
+std::shared_future<std::pair<double, bool>>
+EmployeeManager::calculate_employee_salary_async(const uuid_t& id, const date_t& date) const {
+    return calculate_employee_salary_async(id, to_month(date));
+}
+
+//! Calculate employee salary asynchronously by month ordinal
+std::shared_future<std::pair<double, bool>>
+EmployeeManager::calculate_employee_salary_async(const uuid_t& id, month_t month) const {
+    // Pay attention: request is coalesced only with pending ones of the same data version, so
+    // result is never older than data at moment of request
+    return p_data_->async_requests().request(id, month, p_data_->version.load());
+}
+
+//! Calculate employee salary asynchronously with completion callback
+void EmployeeManager::calculate_employee_salary_async(const uuid_t&  id,
+                                                      const date_t&  date,
+                                                      SalaryCallback callback) const {
+    calculate_employee_salary_async(id, to_month(date), std::move(callback));
+}
+
+//! Calculate employee salary asynchronously with completion callback by month ordinal
+void EmployeeManager::calculate_employee_salary_async(const uuid_t&  id,
+                                                      month_t        month,
+                                                      SalaryCallback callback) const {
+    p_data_->async_requests().request(id, month, p_data_->version.load(), std::move(callback));
+}
+
+//! Calculate salaries of batch of employees asynchronously
+std::future<std::vector<std::pair<double, bool>>>
+EmployeeManager::calculate_employee_salaries_async(const std::vector<uuid_t>& ids,
+                                                   const date_t&              date) const {
+    return calculate_employee_salaries_async(ids, to_month(date));
+}
+
+//! Calculate salaries of batch of employees asynchronously by month ordinal
+std::future<std::vector<std::pair<double, bool>>>
+EmployeeManager::calculate_employee_salaries_async(const std::vector<uuid_t>& ids,
+                                                   month_t                    month) const {
+    return p_data_->async_requests().request(ids, month, p_data_->version.load());
+}
+
+//! Calculate total salary of all employees (whole-company payroll)
+std::pair<double, bool> EmployeeManager::calculate_total_payroll(const date_t& date) const {
+    return calculate_total_payroll(to_month(date));
+}
+
+//! Calculate total salary of all employees by month ordinal
+std::pair<double, bool> EmployeeManager::calculate_total_payroll(month_t month) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::CALCULATE_TOTAL_PAYROLL));
+
+    // Pay attention: the same snapshot logic as for `calculate_employee_salary`
+    const std::shared_ptr<const Snapshot> snapshot = p_data_->pin_snapshot();
+
+    return p_data_->salary_calculator.calculate_total_salary(*snapshot, month);
+}
+
+//! Calculate total salary of all employees for a batch of dates
+std::vector<std::pair<double, bool>>
+EmployeeManager::calculate_total_payroll(const std::vector<date_t>& dates) const {
+    std::vector<month_t> months;
+    months.reserve(dates.size());
+
+    for (const date_t& date : dates) {
+        months.push_back(to_month(date));
+    }
+
+    return calculate_total_payroll(months);
+}
+
+//! Calculate total salary of all employees for a batch of month ordinals
+std::vector<std::pair<double, bool>>
+EmployeeManager::calculate_total_payroll(const std::vector<month_t>& months) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::CALCULATE_TOTAL_PAYROLL));
+
+    // Pay attention: snapshot is pinned once, so all months are calculated over the same data
+    const std::shared_ptr<const Snapshot> snapshot = p_data_->pin_snapshot();
+
+    return p_data_->salary_calculator.calculate_total_salaries(*snapshot, months);
+}
+
+//! Calculate total salary and headcount of every employee category
+std::pair<PayrollByType, bool>
+EmployeeManager::calculate_payroll_by_type(const date_t& date) const {
+    return calculate_payroll_by_type(to_month(date));
+}
+
+//! Calculate total salary and headcount of every employee category by month ordinal
+std::pair<PayrollByType, bool> EmployeeManager::calculate_payroll_by_type(month_t month) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::CALCULATE_PAYROLL_BY_TYPE));
+
+    // Pay attention: the same snapshot logic as for `calculate_employee_salary`
+    const std::shared_ptr<const Snapshot> snapshot = p_data_->pin_snapshot();
+
+    return p_data_->salary_calculator.calculate_payroll_by_type(*snapshot, month);
+}
+
+//! Calculate employee salary for every month of range
+std::vector<std::pair<double, bool>>
+EmployeeManager::calculate_salary_series(const uuid_t& id,
+                                         const date_t& from,
+                                         const date_t& to) const {
+    return calculate_salary_series(id, to_month(from), to_month(to));
+}
+
+//! Calculate employee salary for every month of range of month ordinals
+std::vector<std::pair<double, bool>>
+EmployeeManager::calculate_salary_series(const uuid_t& id, month_t first, month_t last) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::CALCULATE_SALARY_SERIES));
+
+    // Pay attention: snapshot is pinned once, so all months are calculated over the same data
+    const std::shared_ptr<const Snapshot> snapshot = p_data_->pin_snapshot();
+
+    return p_data_->salary_calculator.calculate_salary_series(*snapshot, id, first, last);
+}
+
+//! Calculate total salary of all employees for every month of range
+std::vector<std::pair<double, bool>>
+EmployeeManager::calculate_payroll_series(const date_t& from, const date_t& to) const {
+    return calculate_payroll_series(to_month(from), to_month(to));
+}
+
+//! Calculate total salary of all employees for every month of range of month ordinals
+std::vector<std::pair<double, bool>> EmployeeManager::calculate_payroll_series(month_t first,
+                                                                               month_t last) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::CALCULATE_PAYROLL_SERIES));
+
+    // Pay attention: snapshot is pinned once, so all months are calculated over the same data
+    const std::shared_ptr<const Snapshot> snapshot = p_data_->pin_snapshot();
+
+    return p_data_->salary_calculator.calculate_total_salary_series(*snapshot, first, last);
+}
+
+//! Save all employees and hierarchy to file
+bool EmployeeManager::save(const std::string& path) const {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::SAVE));
+
+    // Pay attention: snapshot is already in hierarchy pre-order, so it is written as is and no
+    // lock is held during writing
+    const std::shared_ptr<const Snapshot> snapshot = p_data_->pin_snapshot();
+
+    return write_registry_file(path, *snapshot);
+}
+
+//! Load all employees and hierarchy from file
+bool EmployeeManager::load(const std::string& path) {
+    ScopedTimer timer(p_data_->operation_stats(ManagerOperation::LOAD));
+
+    // 1.Read and validate file (without lock)
+    const std::optional<RegistryImage> image = read_registry_file(path);
+    if (!image) {
+        return false;
     }
 
-    // 2.Calculate
-    return p_data_->salary_calculator.calculate_month_salary(id, date);
-}
\ No newline at end of file
+    // 2.Create all objects at once (registry must be empty)
+    return p_data_->load_image(*image);
+}
+
+//! Restore registry from registry file and change journal and keep writing changes to journal
+bool EmployeeManager::open_journal(const std::string& registry_path,
+                                   const std::string& journal_path) {
+    std::lock_guard<std::mutex> journal_lock(p_data_->journal_mtx);
+
+    // 1.Validate registry is empty and journal is not opened yet
+    {
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+
+        if (p_data_->employees.size() != 0 || p_data_->journal != nullptr) {
+            return false;
+        }
+    }
+
+    // 2.Registry file
+    std::error_code error;
+    uint64_t        generation = 0;
+
+    if (std::filesystem::exists(registry_path, error)) {
+        const std::optional<RegistryImage> image = read_registry_file(registry_path);
+        if (!image || !p_data_->load_image(*image)) {
+            return false;
+        }
+        generation = image->generation;
+    }
+
+    // 3.Changes made after registry file was written in order of generations (journals of
+    // older generations are included into it, they are left only by interrupted compaction)
+    uint64_t last_generation = generation;
+    for (const auto& [file_generation, path] : find_journal_files(journal_path)) {
+        if (file_generation < generation) {
+            continue;
+        }
+
+        const std::optional<JournalImage> journal = read_journal_file(path);
+        if (!journal || journal->generation != file_generation) {
+            return false;
+        }
+
+        if (!replay_records(*this, journal->records)) {
+            return false;
+        }
+        last_generation = std::max(last_generation, file_generation);
+    }
+
+    // 4.Journal is started from compacted state
+    {
+        TimedUniqueLock lock(p_data_->mtx, p_data_->lock_stats);
+
+        PrivateData* data = p_data_.get();
+
+        data->registry_path      = registry_path;
+        data->journal_path       = journal_path;
+        data->journal_generation = last_generation;
+        data->journal            = std::make_unique<ChangeJournal>(
+            data->config.journal_flush_interval, data->config.journal_compaction_threshold,
+            [data]() {
+                std::lock_guard<std::mutex> compaction_lock(data->journal_mtx);
+                data->compact_journal();
+            });
+    }
+
+    return p_data_->compact_journal();
+}
+
+//! Write to disk and sync all changes made before the call
+bool EmployeeManager::flush_journal() {
+    ChangeJournal* journal = nullptr;
+    {
+        TimedSharedLock lock(p_data_->mtx, p_data_->lock_stats);
+        journal = p_data_->journal.get();
+    }
+
+    return journal != nullptr && journal->flush();
+}
+
+//! Compact change journal
+bool EmployeeManager::compact_journal() {
+    std::lock_guard<std::mutex> journal_lock(p_data_->journal_mtx);
+
+    if (p_data_->journal == nullptr) {
+        return false;
+    }
+
+    return p_data_->compact_journal();
+}
+
+//! Get collected statistics
+EmployeeManagerStats EmployeeManager::stats() const {
+    EmployeeManagerStats stats;
+    stats.enabled = STATS_ENABLED;
+
+    for (size_t i = 0; i < MANAGER_OPERATIONS_COUNT; ++i) {
+        stats.operations[i].latency = p_data_->operations_stats[i].read();
+        stats.operations[i].calls   = stats.operations[i].latency.count;
+    }
+
+    stats.registry_lock = p_data_->lock_stats.read();
+    p_data_->relation_manager.read_stats(stats);
+
+    return stats;
+}
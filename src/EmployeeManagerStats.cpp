@@ -0,0 +1,22 @@
+// lib includes
+#include <employee_lib/EmployeeManagerStats.h>
+
+using namespace employee;
+
+//! Get bucket of value
+size_t Histogram::bucket(uint64_t value) {
+    constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    if (value >> MAX_BITS != 0) {
+        return BUCKETS_COUNT - 1;
+    }
+
+    // Pay attention: the highest bit selects power of two, the next bits select sub-bucket
+    const unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    const unsigned shift    = exponent - SUB_BUCKET_BITS;
+
+    return ((shift + 1) << SUB_BUCKET_BITS) + ((value >> shift) & (SUB_BUCKETS - 1));
+}
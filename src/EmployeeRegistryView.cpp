@@ -0,0 +1,226 @@
+// lib includes
+#include <employee_lib/EmployeeRegistryView.h>
+
+// relative includes
+#include "RegistryFile.h"
+#include "SalaryCalculator.h"
+#include "Snapshot.h"
+
+// C++ includes
+#include <atomic>
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+class EmployeeRegistryView::PrivateData {
+public:
+    /**
+     * @struct Registry
+     * @brief Opened registry: snapshot over mapped file together with its own salary memo
+     */
+    struct Registry {
+        Registry(std::shared_ptr<const MappedRegistryFile> file,
+                 const std::optional<SalaryPolicy>&        salary_policy) :
+            snapshot(0, std::move(file)), salary_calculator(nullptr, salary_policy) {}
+
+        Snapshot         snapshot;
+        SalaryCalculator salary_calculator;
+    };
+
+    //! Get opened registry (nullptr if there is no one)
+    std::shared_ptr<const Registry> pin_registry() const {
+        return std::atomic_load(&registry);
+    }
+
+public:
+    std::optional<SalaryPolicy>     salary_policy; //!< Salary policy (nullopt for built-in one)
+    std::shared_ptr<const Registry> registry;      //!< Opened registry (atomic access)
+};
+
+//! Construct an EmployeeRegistryView object
+EmployeeRegistryView::EmployeeRegistryView() : p_data_(std::make_unique<PrivateData>()) {}
+
+//! Construct an EmployeeRegistryView object with specific salary policy
+EmployeeRegistryView::EmployeeRegistryView(const SalaryPolicy& salary_policy) :
+    EmployeeRegistryView() {
+    p_data_->salary_policy = salary_policy;
+}
+
+//! Destruct an EmployeeRegistryView object
+EmployeeRegistryView::~EmployeeRegistryView() = default;
+
+//! Open registry file
+bool EmployeeRegistryView::open(const std::string& path) {
+    std::shared_ptr<const MappedRegistryFile> file = MappedRegistryFile::open(path);
+    if (file == nullptr) {
+        return false;
+    }
+
+    // Pay attention: queries which pinned previous registry keep its mapping until they finish
+    std::shared_ptr<const PrivateData::Registry> registry =
+        std::make_shared<const PrivateData::Registry>(std::move(file), p_data_->salary_policy);
+    std::atomic_store(&p_data_->registry, registry);
+
+    return true;
+}
+
+//! Get number of employees
+size_t EmployeeRegistryView::size() const {
+    const auto registry = p_data_->pin_registry();
+
+    return registry != nullptr ? registry->snapshot.size() : 0;
+}
+
+//! Find employee by it unique identifier
+std::optional<EmployeeDescr> EmployeeRegistryView::find_employee(const uuid_t& id) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return std::nullopt;
+    }
+
+    const Snapshot&               snapshot = registry->snapshot;
+    const std::optional<uint32_t> index    = snapshot.find(id);
+    if (!index) {
+        return std::nullopt;
+    }
+
+    EmployeeDescr descr{snapshot.type(*index), snapshot.base_salary(*index),
+                        to_date(snapshot.hire_month(*index), snapshot.hire_day(*index))};
+    return descr;
+}
+
+//! Get employee chief
+std::optional<uuid_t> EmployeeRegistryView::get_chief(const uuid_t& id) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return std::nullopt;
+    }
+
+    const Snapshot&               snapshot = registry->snapshot;
+    const std::optional<uint32_t> index    = snapshot.find(id);
+    if (!index || snapshot.chief(*index) == Snapshot::NONE) {
+        return std::nullopt;
+    }
+
+    return snapshot.id(snapshot.chief(*index));
+}
+
+//! Check if employee is direct or indirect subordinate of chief
+bool EmployeeRegistryView::is_subordinate(const uuid_t& chief, const uuid_t& id) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return false;
+    }
+
+    const Snapshot&               snapshot    = registry->snapshot;
+    const std::optional<uint32_t> chief_index = snapshot.find(chief);
+    const std::optional<uint32_t> index       = snapshot.find(id);
+    if (!chief_index || !index) {
+        return false;
+    }
+
+    // Pay attention: subordinates of chief are exactly the rest of his subtree range
+    return *chief_index < *index && *index < snapshot.subtree_end(*chief_index);
+}
+
+//! Get employee direct subordinates
+std::vector<uuid_t> EmployeeRegistryView::get_direct_subordinates(const uuid_t& id) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return {};
+    }
+
+    const Snapshot&               snapshot = registry->snapshot;
+    const std::optional<uint32_t> index    = snapshot.find(id);
+    if (!index) {
+        return {};
+    }
+
+    // Direct subordinates are roots of consecutive subtrees inside subtree range of employee
+    std::vector<uuid_t> result;
+    for (uint32_t i = *index + 1; i < snapshot.subtree_end(*index); i = snapshot.subtree_end(i)) {
+        result.push_back(snapshot.id(i));
+    }
+
+    return result;
+}
+
+//! Get employee all subordinates
+std::vector<uuid_t> EmployeeRegistryView::get_all_subordinates(const uuid_t& id) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return {};
+    }
+
+    const Snapshot&               snapshot = registry->snapshot;
+    const std::optional<uint32_t> index    = snapshot.find(id);
+    if (!index) {
+        return {};
+    }
+
+    return std::vector<uuid_t>(snapshot.ids() + *index + 1,
+                               snapshot.ids() + snapshot.subtree_end(*index));
+}
+
+//! Count employee all subordinates
+size_t EmployeeRegistryView::count_all_subordinates(const uuid_t& id) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return 0;
+    }
+
+    const Snapshot&               snapshot = registry->snapshot;
+    const std::optional<uint32_t> index    = snapshot.find(id);
+
+    return index ? snapshot.subtree_end(*index) - *index - 1 : 0;
+}
+
+//! Calculate employee salary
+std::pair<double, bool> EmployeeRegistryView::calculate_employee_salary(const uuid_t& id,
+                                                                        const date_t& date) const {
+    return calculate_employee_salary(id, to_month(date));
+}
+
+//! Calculate employee salary by month ordinal
+std::pair<double, bool> EmployeeRegistryView::calculate_employee_salary(const uuid_t& id,
+                                                                        month_t month) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return {0.0, false};
+    }
+
+    return registry->salary_calculator.calculate_month_salary(registry->snapshot, id, month);
+}
+
+//! Calculate total salary of all employees (whole-company payroll)
+std::pair<double, bool> EmployeeRegistryView::calculate_total_payroll(const date_t& date) const {
+    return calculate_total_payroll(to_month(date));
+}
+
+//! Calculate total salary of all employees by month ordinal
+std::pair<double, bool> EmployeeRegistryView::calculate_total_payroll(month_t month) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return {0.0, false};
+    }
+
+    return registry->salary_calculator.calculate_total_salary(registry->snapshot, month);
+}
+
+//! Calculate total salary and headcount of every employee category
+std::pair<PayrollByType, bool>
+EmployeeRegistryView::calculate_payroll_by_type(const date_t& date) const {
+    return calculate_payroll_by_type(to_month(date));
+}
+
+//! Calculate total salary and headcount of every employee category by month ordinal
+std::pair<PayrollByType, bool>
+EmployeeRegistryView::calculate_payroll_by_type(month_t month) const {
+    const auto registry = p_data_->pin_registry();
+    if (registry == nullptr) {
+        return {PayrollByType{}, false};
+    }
+
+    return registry->salary_calculator.calculate_payroll_by_type(registry->snapshot, month);
+}
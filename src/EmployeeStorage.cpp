@@ -0,0 +1,133 @@
+// relative includes
+#include "EmployeeStorage.h"
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+//! Construct an empty storage
+EmployeeStorage::EmployeeStorage(std::pmr::memory_resource* upstream) :
+    ids_(upstream != nullptr ? upstream : std::pmr::new_delete_resource()),
+    types_(ids_.get_allocator()),
+    base_salaries_(ids_.get_allocator()),
+    hire_months_(ids_.get_allocator()),
+    hire_days_(ids_.get_allocator()) {}
+
+//! Register employee
+uint32_t EmployeeStorage::emplace(const EmployeeDescr& description, const uuid_t& id) {
+    switch (description.type) {
+        case EmployeeType::WORKER:
+        case EmployeeType::FOREMAN:
+        case EmployeeType::MANAGER:
+            break;
+
+        default:
+            return NONE;
+    }
+
+    const uint32_t slot = static_cast<uint32_t>(ids_.size());
+
+    // Single lookup both for validation and for registration of identifier
+    if (!slots_.emplace(id, slot).second) {
+        return NONE;
+    }
+
+    ids_.push_back(id);
+    types_.push_back(description.type);
+    base_salaries_.push_back(description.base_salary);
+    hire_months_.push_back(to_month(description.hire_date));
+    hire_days_.push_back(static_cast<uint8_t>(description.hire_date.day()));
+
+    return slot;
+}
+
+//! Reserve columns for given total number of employees
+void EmployeeStorage::reserve(size_t count) {
+    slots_.reserve(count);
+
+    ids_.reserve(count);
+    types_.reserve(count);
+    base_salaries_.reserve(count);
+    hire_months_.reserve(count);
+    hire_days_.reserve(count);
+}
+
+//! Unregister employee
+bool EmployeeStorage::erase(const uuid_t& id) {
+    auto it = slots_.find(id);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    const uint32_t slot = it->second;
+    const uint32_t last = static_cast<uint32_t>(ids_.size()) - 1;
+
+    slots_.erase(it);
+
+    // Keep columns dense: move the last employee to the hole
+    if (slot != last) {
+        ids_[slot]           = ids_[last];
+        types_[slot]         = types_[last];
+        base_salaries_[slot] = base_salaries_[last];
+        hire_months_[slot]   = hire_months_[last];
+        hire_days_[slot]     = hire_days_[last];
+
+        slots_[ids_[slot]] = slot;
+    }
+
+    ids_.pop_back();
+    types_.pop_back();
+    base_salaries_.pop_back();
+    hire_months_.pop_back();
+    hire_days_.pop_back();
+
+    return true;
+}
+
+//! Find employee description
+std::optional<EmployeeDescr> EmployeeStorage::find(const uuid_t& id) const {
+    const uint32_t slot = find_slot(id);
+    if (slot == NONE) {
+        return std::nullopt;
+    }
+
+    EmployeeDescr descr{types_[slot], base_salaries_[slot],
+                        to_date(hire_months_[slot], hire_days_[slot])};
+    return descr;
+}
+
+//! Find slot of employee
+uint32_t EmployeeStorage::find_slot(const uuid_t& id) const {
+    auto it = slots_.find(id);
+    return (it != slots_.end()) ? it->second : NONE;
+}
+
+//! Get number of employees
+uint32_t EmployeeStorage::size() const {
+    return static_cast<uint32_t>(ids_.size());
+}
+
+//! Get column of unique identifiers
+const std::pmr::vector<uuid_t>& EmployeeStorage::ids() const {
+    return ids_;
+}
+
+//! Get column of categories
+const std::pmr::vector<EmployeeType>& EmployeeStorage::types() const {
+    return types_;
+}
+
+//! Get column of base salaries
+const std::pmr::vector<double>& EmployeeStorage::base_salaries() const {
+    return base_salaries_;
+}
+
+//! Get column of hire months
+const std::pmr::vector<month_t>& EmployeeStorage::hire_months() const {
+    return hire_months_;
+}
+
+//! Get column of days of hire dates
+const std::pmr::vector<uint8_t>& EmployeeStorage::hire_days() const {
+    return hire_days_;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+#include <employee_lib/Month.h>
+
+// boost includes
+#include <boost/unordered_map.hpp>
+#include <boost/uuid/uuid.hpp>
+
+// C++ includes
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class EmployeeStorage
+ * @brief Class that keeps employees attributes in dense columns
+ *
+ * Every employee occupies a slot (dense integer handle); slots are always packed into range
+ * [0, size()), so full-table scans over columns are sequential and cache-friendly.
+ * Attention! Slot of employee can be changed by `erase` (the last one is moved to the hole),
+ * so slots must not be kept between modifications.
+ *
+ * Columns are the only copy of employees attributes: descriptions are rebuilt from them.
+ */
+class EmployeeStorage {
+public:
+    //!< Slot value for absent employee
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    EmployeeStorage(const EmployeeStorage& other)  = delete;
+    EmployeeStorage(const EmployeeStorage&& other) = delete;
+
+    EmployeeStorage& operator=(const EmployeeStorage& other)  = delete;
+    EmployeeStorage& operator=(const EmployeeStorage&& other) = delete;
+
+    EmployeeStorage() = delete;
+
+    /**
+     * @brief Construct an empty storage
+     * @param upstream memory resource for columns (nullptr for default one)
+     */
+    explicit EmployeeStorage(std::pmr::memory_resource* upstream);
+
+    /**
+     * @brief Register employee
+     * @param description employee description
+     * @param id employee unique identifier
+     * @return slot of employee (`NONE` for unknown category or already registered identifier)
+     */
+    uint32_t emplace(const EmployeeDescr& description, const boost::uuids::uuid& id);
+
+    /**
+     * @brief Reserve columns for given total number of employees
+     * @param count total number of employees
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Unregister employee
+     * @param id employee unique identifier
+     * @return was erased or not
+     */
+    bool erase(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Find employee description
+     * @param id employee unique identifier
+     * @return employee description (optional value)
+     */
+    std::optional<EmployeeDescr> find(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Find slot of employee
+     * @param id employee unique identifier
+     * @return slot (`NONE` if there is no such employee)
+     */
+    uint32_t find_slot(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get number of employees
+     */
+    uint32_t size() const;
+
+    /**
+     * @brief Get column of unique identifiers
+     */
+    const std::pmr::vector<boost::uuids::uuid>& ids() const;
+
+    /**
+     * @brief Get column of categories
+     */
+    const std::pmr::vector<EmployeeType>& types() const;
+
+    /**
+     * @brief Get column of base salaries
+     */
+    const std::pmr::vector<double>& base_salaries() const;
+
+    /**
+     * @brief Get column of hire months
+     */
+    const std::pmr::vector<month_t>& hire_months() const;
+
+    /**
+     * @brief Get column of days of hire dates
+     */
+    const std::pmr::vector<uint8_t>& hire_days() const;
+
+private:
+    //!< Relation "unique identifier-->slot"
+    boost::unordered_map<boost::uuids::uuid, uint32_t> slots_;
+
+    std::pmr::vector<boost::uuids::uuid> ids_;           //!< Unique identifiers
+    std::pmr::vector<EmployeeType>       types_;         //!< Categories
+    std::pmr::vector<double>             base_salaries_; //!< Base salaries
+    std::pmr::vector<month_t>            hire_months_;   //!< Hire months
+    std::pmr::vector<uint8_t>            hire_days_;     //!< Days of hire dates
+};
+
+} // namespace employee
@@ -0,0 +1,65 @@
+// relative includes
+#include "Executor.h"
+
+// C++ includes
+#include <algorithm>
+
+using employee::Executor;
+
+//! Construct executor and start its threads
+Executor::Executor(size_t threads) : stop_(false) {
+    threads = std::max<size_t>(threads, 1);
+
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&Executor::work, this);
+    }
+}
+
+//! Execute all queued tasks, stop threads and destruct executor
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+//! Get number of threads
+size_t Executor::size() const {
+    return threads_.size();
+}
+
+//! Queue task
+void Executor::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+//! Thread function
+void Executor::work() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+
+            // Pay attention: queue is drained before exit
+            if (tasks_.empty()) {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
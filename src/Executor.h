@@ -0,0 +1,72 @@
+#pragma once
+
+// C++ includes
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class Executor
+ * @brief Class of executor of asynchronous tasks (fixed number of threads with FIFO queue)
+ *
+ * Unlike `ThreadPool` it does not wait for tasks: caller submits a task and continues. Tasks
+ * queued before destruction are still executed, so every promised result is delivered.
+ */
+class Executor {
+public:
+    //!< Asynchronous task
+    using Task = std::function<void()>;
+
+    Executor() = delete;
+
+    Executor(const Executor& other)  = delete;
+    Executor(const Executor&& other) = delete;
+
+    Executor& operator=(const Executor& other)  = delete;
+    Executor& operator=(const Executor&& other) = delete;
+
+    /**
+     * @brief Construct executor and start its threads
+     * @param threads number of threads (at least one)
+     */
+    explicit Executor(size_t threads);
+
+    /**
+     * @brief Execute all queued tasks, stop threads and destruct executor
+     */
+    ~Executor();
+
+    /**
+     * @brief Get number of threads
+     */
+    size_t size() const;
+
+    /**
+     * @brief Queue task (it is executed by one of threads of executor)
+     * @param task task
+     */
+    void submit(Task task);
+
+private:
+    /**
+     * @brief Thread function
+     */
+    void work();
+
+private:
+    std::vector<std::thread> threads_; //!< Threads
+
+    std::mutex              mtx_;   //!< Mutex for threads sync
+    std::condition_variable cv_;    //!< Wakes idle threads up
+    std::deque<Task>        tasks_; //!< Queued tasks
+    bool                    stop_;  //!< Threads must exit after the last queued task
+};
+
+} // namespace employee
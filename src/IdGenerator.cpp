@@ -0,0 +1,48 @@
+// relative includes
+#include "IdGenerator.h"
+
+// boost includes
+#include <boost/uuid/uuid_generators.hpp>
+
+// C++ includes
+#include <cstring>
+#include <random>
+
+using uuid_t = boost::uuids::uuid;
+
+namespace
+{
+
+//! Generate UUID (version 4) by fast pseudo-random generator
+uuid_t generate_fast_id() {
+    // Seed from OS entropy source only once per thread
+    thread_local std::mt19937_64 engine = []() {
+        std::random_device device;
+        std::seed_seq      seed{device(), device(), device(), device()};
+        return std::mt19937_64{seed};
+    }();
+
+    const uint64_t words[2] = {engine(), engine()};
+
+    uuid_t id;
+    std::memcpy(id.data, words, sizeof(words));
+
+    // Version 4 and RFC 4122 variant bits
+    id.data[6] = static_cast<uint8_t>((id.data[6] & 0x0F) | 0x40);
+    id.data[8] = static_cast<uint8_t>((id.data[8] & 0x3F) | 0x80);
+
+    return id;
+}
+
+//! Generate UUID (version 4) from OS entropy source
+uuid_t generate_secure_id() {
+    thread_local boost::uuids::random_generator generator;
+    return generator();
+}
+
+} // namespace
+
+//! Generate random (version 4) unique identifier
+uuid_t employee::generate_id(IdGeneratorType type) {
+    return (type == IdGeneratorType::FAST) ? generate_fast_id() : generate_secure_id();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeManagerConfig.h>
+
+// boost includes
+#include <boost/uuid/uuid.hpp>
+
+namespace employee
+{
+
+/**
+ * @brief Generate random (version 4) unique identifier
+ * Generators are thread-local: each of them is created and seeded once per thread and then used
+ * without any lock
+ * @param type generator type
+ * @return unique identifier
+ */
+boost::uuids::uuid generate_id(IdGeneratorType type);
+
+} // namespace employee
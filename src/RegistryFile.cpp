@@ -0,0 +1,331 @@
+// relative includes
+#include "RegistryFile.h"
+#include "DurableFile.h"
+#include "Snapshot.h"
+
+// C++ includes
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+// system includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+namespace
+{
+
+//! Round size up to 8 bytes
+size_t align_8(size_t size) {
+    return (size + 7) & ~size_t{7};
+}
+
+//! Validate header of registry file image (together with image size)
+std::optional<RegistryFileHeader> validate_header(const char* data, size_t size) {
+    if (size < sizeof(RegistryFileHeader)) {
+        return std::nullopt;
+    }
+
+    RegistryFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, REGISTRY_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.format_version != REGISTRY_FILE_VERSION ||
+        header.byte_order_mark != REGISTRY_FILE_BYTE_ORDER_MARK ||
+        header.count >= std::numeric_limits<uint32_t>::max()) {
+        return std::nullopt;
+    }
+
+    if (registry_file_layout(header.count).size != size) {
+        return std::nullopt;
+    }
+
+    return header;
+}
+
+//! Validate employee: known category, convertible hire date, chief precedes his subordinate (so
+//! there are no cycles) and is not worker
+bool is_valid_employee(uint32_t       i,
+                       const uint8_t* types,
+                       month_t        hire_month,
+                       uint8_t        hire_day,
+                       uint32_t       chief) {
+    if (types[i] > static_cast<uint8_t>(EmployeeType::MANAGER) ||
+        !is_valid_date(hire_month, hire_day)) {
+        return false;
+    }
+
+    return chief == Snapshot::NONE ||
+           (chief < i && types[chief] != static_cast<uint8_t>(EmployeeType::WORKER));
+}
+
+} // namespace
+
+//! Get layout of registry file
+RegistryFileLayout employee::registry_file_layout(uint64_t count) {
+    RegistryFileLayout layout{};
+
+    layout.ids           = sizeof(RegistryFileHeader);
+    layout.base_salaries = layout.ids + count * sizeof(uuid_t);
+    layout.hire_months   = layout.base_salaries + count * sizeof(double);
+    layout.chiefs        = layout.hire_months + count * sizeof(month_t);
+    layout.subtree_ends  = layout.chiefs + count * sizeof(uint32_t);
+    layout.id_index      = layout.subtree_ends + count * sizeof(uint32_t);
+    layout.types         = layout.id_index + count * sizeof(uint32_t);
+    layout.hire_days     = layout.types + count * sizeof(uint8_t);
+    layout.size          = align_8(layout.hire_days + count * sizeof(uint8_t));
+
+    return layout;
+}
+
+//! Write employees and hierarchy of snapshot to registry file
+bool employee::write_registry_file(const std::string& path,
+                                   const Snapshot&    snapshot,
+                                   uint64_t           generation) {
+    const uint32_t           count  = snapshot.size();
+    const RegistryFileLayout layout = registry_file_layout(count);
+
+    // 1.Image of the whole file
+    std::vector<char> buffer(layout.size, 0);
+
+    RegistryFileHeader header{};
+    std::memcpy(header.magic, REGISTRY_FILE_MAGIC, sizeof(header.magic));
+    header.format_version  = REGISTRY_FILE_VERSION;
+    header.byte_order_mark = REGISTRY_FILE_BYTE_ORDER_MARK;
+    header.count           = count;
+    header.generation      = generation;
+
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + layout.ids, snapshot.ids(), count * sizeof(uuid_t));
+    std::memcpy(buffer.data() + layout.base_salaries, snapshot.base_salaries(),
+                count * sizeof(double));
+    std::memcpy(buffer.data() + layout.hire_months, snapshot.hire_months(),
+                count * sizeof(month_t));
+    std::memcpy(buffer.data() + layout.chiefs, snapshot.chiefs(), count * sizeof(uint32_t));
+    std::memcpy(buffer.data() + layout.subtree_ends, snapshot.subtree_ends(),
+                count * sizeof(uint32_t));
+    std::memcpy(buffer.data() + layout.types, snapshot.types(), count * sizeof(uint8_t));
+    std::memcpy(buffer.data() + layout.hire_days, snapshot.hire_days(), count * sizeof(uint8_t));
+
+    // Pay attention: ordered indices let mapped file be searched by unique identifier without
+    // building of any index
+    std::vector<uint32_t> id_index(count);
+    std::iota(id_index.begin(), id_index.end(), 0);
+    std::sort(id_index.begin(), id_index.end(), [&snapshot](uint32_t lhs, uint32_t rhs) -> bool {
+        return snapshot.id(lhs) < snapshot.id(rhs);
+    });
+
+    std::memcpy(buffer.data() + layout.id_index, id_index.data(), count * sizeof(uint32_t));
+
+    // 2.Write temporary file and replace target one by it
+    return replace_file(path, buffer.data(), buffer.size());
+}
+
+//! Read registry file by a single read and validate it
+std::optional<RegistryImage> employee::read_registry_file(const std::string& path) {
+    // 1.Whole file by a single read
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    const std::streamoff size = file.tellg();
+    if (size < static_cast<std::streamoff>(sizeof(RegistryFileHeader))) {
+        return std::nullopt;
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(size));
+
+    file.seekg(0);
+    if (!file.read(buffer.data(), size)) {
+        return std::nullopt;
+    }
+
+    // 2.Validate header and size (columns which are not needed here are skipped)
+    const std::optional<RegistryFileHeader> header = validate_header(buffer.data(), buffer.size());
+    if (!header) {
+        return std::nullopt;
+    }
+
+    const uint32_t           count  = static_cast<uint32_t>(header->count);
+    const RegistryFileLayout layout = registry_file_layout(count);
+
+    // 3.Columns
+    RegistryImage image;
+    image.generation = header->generation;
+    image.ids.resize(count);
+    image.types.resize(count);
+    image.base_salaries.resize(count);
+    image.hire_months.resize(count);
+    image.hire_days.resize(count);
+    image.chiefs.resize(count);
+
+    std::memcpy(image.ids.data(), buffer.data() + layout.ids, count * sizeof(uuid_t));
+    std::memcpy(image.base_salaries.data(), buffer.data() + layout.base_salaries,
+                count * sizeof(double));
+    std::memcpy(image.hire_months.data(), buffer.data() + layout.hire_months,
+                count * sizeof(month_t));
+    std::memcpy(image.chiefs.data(), buffer.data() + layout.chiefs, count * sizeof(uint32_t));
+    std::memcpy(image.hire_days.data(), buffer.data() + layout.hire_days, count * sizeof(uint8_t));
+
+    // 4.Validate values
+    const uint8_t* types = reinterpret_cast<const uint8_t*>(buffer.data() + layout.types);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!is_valid_employee(i, types, image.hire_months[i], image.hire_days[i],
+                               image.chiefs[i])) {
+            return std::nullopt;
+        }
+        image.types[i] = static_cast<EmployeeType>(types[i]);
+    }
+
+    return image;
+}
+
+//! Map registry file and validate it
+std::shared_ptr<const MappedRegistryFile> MappedRegistryFile::open(const std::string& path) {
+    // 1.Map the whole file
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0 ||
+        status.st_size < static_cast<off_t>(sizeof(RegistryFileHeader))) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t size = static_cast<size_t>(status.st_size);
+    void*        data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // Pay attention: mapping stays valid after its descriptor is closed
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // 2.Validate header and size
+    const char*                             bytes  = static_cast<const char*>(data);
+    const std::optional<RegistryFileHeader> header = validate_header(bytes, size);
+    if (!header) {
+        ::munmap(data, size);
+        return nullptr;
+    }
+
+    // 3.Validate columns (mapping is owned by object from here)
+    const uint32_t count = static_cast<uint32_t>(header->count);
+
+    std::shared_ptr<const MappedRegistryFile> file(new MappedRegistryFile(bytes, size, count));
+    if (!file->validate()) {
+        return nullptr;
+    }
+
+    return file;
+}
+
+//! Construct mapped file
+MappedRegistryFile::MappedRegistryFile(const char* data, size_t size, uint32_t count) :
+    data_(data), size_(size), count_(count), layout_(registry_file_layout(count)) {}
+
+//! Unmap file
+MappedRegistryFile::~MappedRegistryFile() {
+    ::munmap(const_cast<char*>(data_), size_);
+}
+
+//! Validate columns
+bool MappedRegistryFile::validate() const {
+    const uint32_t* chiefs_column = chiefs();
+    const uint32_t* ends_column   = subtree_ends();
+    const uint32_t* index_column  = id_index();
+
+    // 1.Employees (chiefs precede their subordinates)
+    for (uint32_t i = 0; i < count_; ++i) {
+        if (!is_valid_employee(i, types(), hire_months()[i], hire_days()[i], chiefs_column[i])) {
+            return false;
+        }
+    }
+
+    // 2.Subtree ranges: every range is inside range of chief and its size matches the number of
+    // subordinates, so ranges are exactly subtrees in pre-order
+    std::vector<uint32_t> subtree_sizes(count_, 1);
+    for (uint32_t i = count_; i > 0; --i) {
+        if (chiefs_column[i - 1] != Snapshot::NONE) {
+            subtree_sizes[chiefs_column[i - 1]] += subtree_sizes[i - 1];
+        }
+    }
+
+    for (uint32_t i = 0; i < count_; ++i) {
+        const uint32_t chief = chiefs_column[i];
+        if (ends_column[i] != i + subtree_sizes[i] ||
+            (chief != Snapshot::NONE && (i >= ends_column[chief] ||
+                                         ends_column[i] > ends_column[chief]))) {
+            return false;
+        }
+    }
+
+    // 3.Ordered indices: strictly ascending unique identifiers (so indices are a permutation and
+    // identifiers are unique)
+    for (uint32_t k = 0; k < count_; ++k) {
+        if (index_column[k] >= count_ ||
+            (k > 0 && !(ids()[index_column[k - 1]] < ids()[index_column[k]]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! Get number of employees
+uint32_t MappedRegistryFile::size() const {
+    return count_;
+}
+
+//! Get column of unique identifiers
+const uuid_t* MappedRegistryFile::ids() const {
+    return reinterpret_cast<const uuid_t*>(data_ + layout_.ids);
+}
+
+//! Get column of categories
+const uint8_t* MappedRegistryFile::types() const {
+    return reinterpret_cast<const uint8_t*>(data_ + layout_.types);
+}
+
+//! Get column of base salaries
+const double* MappedRegistryFile::base_salaries() const {
+    return reinterpret_cast<const double*>(data_ + layout_.base_salaries);
+}
+
+//! Get column of hire months
+const month_t* MappedRegistryFile::hire_months() const {
+    return reinterpret_cast<const month_t*>(data_ + layout_.hire_months);
+}
+
+//! Get column of days of hire dates
+const uint8_t* MappedRegistryFile::hire_days() const {
+    return reinterpret_cast<const uint8_t*>(data_ + layout_.hire_days);
+}
+
+//! Get column of chiefs indices
+const uint32_t* MappedRegistryFile::chiefs() const {
+    return reinterpret_cast<const uint32_t*>(data_ + layout_.chiefs);
+}
+
+//! Get column of subtree ranges ends
+const uint32_t* MappedRegistryFile::subtree_ends() const {
+    return reinterpret_cast<const uint32_t*>(data_ + layout_.subtree_ends);
+}
+
+//! Get column of indices ordered by unique identifiers
+const uint32_t* MappedRegistryFile::id_index() const {
+    return reinterpret_cast<const uint32_t*>(data_ + layout_.id_index);
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+#include <employee_lib/Month.h>
+
+// boost includes
+#include <boost/uuid/uuid.hpp>
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace employee
+{
+
+class Snapshot;
+
+/**
+ * @struct RegistryFileHeader
+ * @brief Header of registry file
+ *
+ * File format (version 1, native byte order checked by byte order mark):
+ * - header;
+ * - columns of employees in hierarchy pre-order, every column is naturally aligned:
+ *   unique identifiers (16 bytes each), base salaries (double), hire months (int32), chiefs
+ *   indices (uint32, UINT32_MAX for top-level employee; chief always precedes his
+ *   subordinates), ends of subtree ranges (uint32), indices of employees ordered by unique
+ *   identifiers (uint32), categories (uint8), days of hire dates (uint8), zero padding up to 8
+ *   bytes.
+ */
+struct RegistryFileHeader {
+    char     magic[8];        //!< File signature (`REGISTRY_FILE_MAGIC`)
+    uint32_t format_version;  //!< Version of file format
+    uint32_t byte_order_mark; //!< `REGISTRY_FILE_BYTE_ORDER_MARK` in byte order of writer
+    uint64_t count;           //!< Number of employees
+    uint64_t generation;      //!< Generation of change journal continuing the file (0 if none)
+};
+
+/**
+ * @struct RegistryFileLayout
+ * @brief Offsets of registry file columns (in bytes from the beginning of file)
+ */
+struct RegistryFileLayout {
+    size_t ids;           //!< Offset of unique identifiers column
+    size_t base_salaries; //!< Offset of base salaries column
+    size_t hire_months;   //!< Offset of hire months column
+    size_t chiefs;        //!< Offset of chiefs indices column
+    size_t subtree_ends;  //!< Offset of subtree ranges ends column
+    size_t id_index;      //!< Offset of ordered indices column
+    size_t types;         //!< Offset of categories column
+    size_t hire_days;     //!< Offset of days of hire dates column
+    size_t size;          //!< Size of the whole file
+};
+
+/**
+ * @struct RegistryImage
+ * @brief Employees and hierarchy read from registry file (columns in hierarchy pre-order)
+ */
+struct RegistryImage {
+    uint64_t                        generation;    //!< Generation of change journal (0 if none)
+    std::vector<boost::uuids::uuid> ids;           //!< Unique identifiers
+    std::vector<EmployeeType>       types;         //!< Categories
+    std::vector<double>             base_salaries; //!< Base salaries
+    std::vector<month_t>            hire_months;   //!< Hire months
+    std::vector<uint8_t>            hire_days;     //!< Days of hire dates
+    std::vector<uint32_t>           chiefs;        //!< Chiefs indices (UINT32_MAX for top-level)
+};
+
+//!< Signature of registry file
+constexpr char REGISTRY_FILE_MAGIC[8] = {'E', 'M', 'P', 'L', 'R', 'E', 'G', '\0'};
+
+//!< Version of registry file format
+constexpr uint32_t REGISTRY_FILE_VERSION = 1;
+
+//!< Byte order mark of registry file
+constexpr uint32_t REGISTRY_FILE_BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * @brief Get layout of registry file
+ * @param count number of employees
+ * @return offsets of columns
+ */
+RegistryFileLayout registry_file_layout(uint64_t count);
+
+/**
+ * @brief Write employees and hierarchy of snapshot to registry file
+ * File is written as a whole and synced to temporary one, which then replaces target file (so
+ * target file is never left half-written)
+ * @param path file path
+ * @param snapshot snapshot of employees and hierarchy
+ * @param generation generation of change journal continuing the file (0 if none)
+ * @return success status
+ */
+bool write_registry_file(const std::string& path,
+                         const Snapshot&    snapshot,
+                         uint64_t           generation = 0);
+
+/**
+ * @brief Read registry file by a single read and validate it
+ * Structure is validated (header, size, categories, hire dates, chiefs indices), identifiers
+ * are not (they are validated by registration)
+ * @param path file path
+ * @return employees and hierarchy (nullopt if file can't be read or is not valid)
+ */
+std::optional<RegistryImage> read_registry_file(const std::string& path);
+
+/**
+ * @class MappedRegistryFile
+ * @brief Registry file mapped to memory for read-only access to its columns in place
+ *
+ * File is mapped as shared one, so pages of the same file are shared by all processes that map
+ * it. Mapping is never modified and is valid while the object exists.
+ */
+class MappedRegistryFile {
+public:
+    MappedRegistryFile(const MappedRegistryFile& other)  = delete;
+    MappedRegistryFile(const MappedRegistryFile&& other) = delete;
+
+    MappedRegistryFile& operator=(const MappedRegistryFile& other)  = delete;
+    MappedRegistryFile& operator=(const MappedRegistryFile&& other) = delete;
+
+    MappedRegistryFile() = delete;
+
+    /**
+     * @brief Map registry file and validate it
+     * The whole structure is validated (the same rules as for `read_registry_file`, plus subtree
+     * ranges must match chiefs and ordered indices must order unique identifiers strictly), so
+     * queries over mapping never read out of it
+     * @param path file path
+     * @return mapped file (nullptr if file can't be mapped or is not valid)
+     */
+    static std::shared_ptr<const MappedRegistryFile> open(const std::string& path);
+
+    /**
+     * @brief Unmap file
+     */
+    ~MappedRegistryFile();
+
+    /**
+     * @brief Get number of employees
+     */
+    uint32_t size() const;
+
+    /**
+     * @brief Get column of unique identifiers
+     */
+    const boost::uuids::uuid* ids() const;
+
+    /**
+     * @brief Get column of categories
+     */
+    const uint8_t* types() const;
+
+    /**
+     * @brief Get column of base salaries
+     */
+    const double* base_salaries() const;
+
+    /**
+     * @brief Get column of hire months
+     */
+    const month_t* hire_months() const;
+
+    /**
+     * @brief Get column of days of hire dates
+     */
+    const uint8_t* hire_days() const;
+
+    /**
+     * @brief Get column of chiefs indices
+     */
+    const uint32_t* chiefs() const;
+
+    /**
+     * @brief Get column of subtree ranges ends
+     */
+    const uint32_t* subtree_ends() const;
+
+    /**
+     * @brief Get column of indices ordered by unique identifiers
+     */
+    const uint32_t* id_index() const;
+
+private:
+    /**
+     * @brief Construct mapped file
+     * @param data mapping address
+     * @param size mapping size
+     * @param count number of employees
+     */
+    MappedRegistryFile(const char* data, size_t size, uint32_t count);
+
+    /**
+     * @brief Validate columns
+     */
+    bool validate() const;
+
+    const char*        data_;   //!< Mapping address
+    size_t             size_;   //!< Mapping size
+    uint32_t           count_;  //!< Number of employees
+    RegistryFileLayout layout_; //!< Offsets of columns
+};
+
+} // namespace employee
@@ -0,0 +1,205 @@
+// relative includes
+#include "RegistryVersion.h"
+
+// C++ includes
+#include <atomic>
+#include <cstring>
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+namespace
+{
+
+//! Generate unique identifier of editor (published nodes keep identifiers of finished editors)
+uint64_t next_owner() {
+    static std::atomic<uint64_t> counter{0};
+
+    return ++counter;
+}
+
+} // namespace
+
+//! Construct empty version
+RegistryVersion::RegistryVersion() : version_(0), size_(0) {}
+
+//! Construct published version
+RegistryVersion::RegistryVersion(uint64_t version, uint32_t size, std::shared_ptr<Node> root) :
+    version_(version), size_(size), root_(std::move(root)) {}
+
+//! Get version of source data
+uint64_t RegistryVersion::version() const {
+    return version_;
+}
+
+//! Get number of employees
+uint32_t RegistryVersion::size() const {
+    return size_;
+}
+
+//! Find employee record
+const RegistryVersion::Record* RegistryVersion::find(const uuid_t& id) const {
+    return find(root_.get(), id);
+}
+
+//! Visit all records
+void RegistryVersion::for_each(const Visitor& visitor) const {
+    if (root_ == nullptr) {
+        return;
+    }
+
+    // Depth-first walk over trie: inner nodes are on levels [0, DEPTH), leaves are on the last one
+    std::vector<std::pair<const Node*, uint32_t>> tower{{root_.get(), 0}};
+
+    while (!tower.empty()) {
+        const auto [node, level] = tower.back();
+        tower.pop_back();
+
+        if (level == DEPTH) {
+            for (const auto& [id, record] : static_cast<const Leaf*>(node)->records) {
+                visitor(id, record);
+            }
+            continue;
+        }
+
+        const Branch& branch = *static_cast<const Branch*>(node);
+        for (uint32_t i = FANOUT; i > 0; --i) {
+            if (branch.children[i - 1] != nullptr) {
+                tower.emplace_back(branch.children[i - 1].get(), level + 1);
+            }
+        }
+    }
+}
+
+//! Get hash of employee unique identifier
+uint64_t RegistryVersion::hash(const uuid_t& id) {
+    // Pay attention: halves of identifier are folded and mixed by finalizer of splitmix64, so
+    // identifiers different in a few bytes (e.g. sequential ones) spread over all levels of trie
+    uint64_t halves[2];
+    std::memcpy(halves, id.data, sizeof(halves));
+
+    uint64_t h = halves[0] ^ halves[1];
+    h          = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h          = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+
+    return h ^ (h >> 31);
+}
+
+//! Get index of child of inner node for hash
+uint32_t RegistryVersion::child_index(uint64_t hash, uint32_t level) {
+    return static_cast<uint32_t>(hash >> (64 - LEVEL_BITS * (level + 1))) & (FANOUT - 1);
+}
+
+//! Find record in trie
+const RegistryVersion::Record* RegistryVersion::find(const Node* root, const uuid_t& id) {
+    const uint64_t h = hash(id);
+
+    const Node* node = root;
+    for (uint32_t level = 0; level < DEPTH && node != nullptr; ++level) {
+        node = static_cast<const Branch*>(node)->children[child_index(h, level)].get();
+    }
+
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    for (const auto& [key, record] : static_cast<const Leaf*>(node)->records) {
+        if (key == id) {
+            return &record;
+        }
+    }
+
+    return nullptr;
+}
+
+//! Construct editor
+RegistryVersion::Editor::Editor(const RegistryVersion& base) :
+    root_(base.root_), size_(base.size_), owner_(next_owner()) {}
+
+//! Find employee record in edited version
+const RegistryVersion::Record* RegistryVersion::Editor::find(const uuid_t& id) const {
+    return RegistryVersion::find(root_.get(), id);
+}
+
+//! Insert or replace employee record
+void RegistryVersion::Editor::put(const uuid_t& id, const Record& record) {
+    std::vector<std::pair<uuid_t, Record>>& records =
+        static_cast<Leaf&>(*own_leaf(hash(id))).records;
+
+    for (auto& [key, value] : records) {
+        if (key == id) {
+            value = record;
+            return;
+        }
+    }
+
+    records.emplace_back(id, record);
+    ++size_;
+}
+
+//! Remove employee record
+bool RegistryVersion::Editor::erase(const uuid_t& id) {
+    // Absent record: nothing is copied
+    if (find(id) == nullptr) {
+        return false;
+    }
+
+    std::shared_ptr<Node>&                  leaf    = own_leaf(hash(id));
+    std::vector<std::pair<uuid_t, Record>>& records = static_cast<Leaf&>(*leaf).records;
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].first == id) {
+            records[i] = std::move(records.back());
+            records.pop_back();
+            break;
+        }
+    }
+
+    if (records.empty()) {
+        leaf.reset();
+    }
+    --size_;
+
+    return true;
+}
+
+//! Publish edited version
+std::shared_ptr<const RegistryVersion> RegistryVersion::Editor::publish(uint64_t version) {
+    std::shared_ptr<const RegistryVersion> published(new RegistryVersion(version, size_, root_));
+
+    // Published nodes must not be changed anymore
+    owner_ = next_owner();
+
+    return published;
+}
+
+//! Get link to leaf of hash with all nodes on path owned by editor
+std::shared_ptr<RegistryVersion::Node>& RegistryVersion::Editor::own_leaf(uint64_t hash) {
+    std::shared_ptr<Node>* link = &root_;
+
+    for (uint32_t level = 0; level <= DEPTH; ++level) {
+        std::shared_ptr<Node>& node = *link;
+
+        // Absent node is created, node of another version is copied (leaves on the last level)
+        if (node == nullptr || node->owner != owner_) {
+            if (level == DEPTH) {
+                node = (node == nullptr) ? std::make_shared<Leaf>()
+                                         : std::make_shared<Leaf>(static_cast<const Leaf&>(*node));
+            } else {
+                node = (node == nullptr)
+                           ? std::make_shared<Branch>()
+                           : std::make_shared<Branch>(static_cast<const Branch&>(*node));
+            }
+            node->owner = owner_;
+        }
+
+        if (level == DEPTH) {
+            return node;
+        }
+
+        link = &static_cast<Branch&>(*node).children[child_index(hash, level)];
+    }
+
+    return *link;
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+#include <employee_lib/Month.h>
+
+// boost includes
+#include <boost/uuid/uuid.hpp>
+
+// C++ includes
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class RegistryVersion
+ * @brief Immutable version of employees together with hierarchy published by writers
+ *
+ * Records are kept in hash trie of fixed depth. New version is made copy-on-write: it shares all
+ * unchanged nodes of trie with previous one, so change of a few records costs a few copied nodes
+ * (path from root to record) instead of copy of the whole registry.
+ *
+ * Published version is never modified, so it is read without any lock.
+ */
+class RegistryVersion {
+public:
+    /**
+     * @struct Record
+     * @brief Employee together with his relations
+     */
+    struct Record {
+        EmployeeType       type         = EmployeeType::WORKER; //!< Category
+        double             base_salary  = 0.0;                  //!< Base salary
+        month_t            hire_month   = 0;                    //!< Hire month
+        uint8_t            hire_day     = 1;                    //!< Day of hire date
+        uint32_t           subtree_size = 0;                    //!< Number of all subordinates
+        boost::uuids::uuid chief{}; //!< Chief unique identifier (nil for top-level employee)
+
+        //!< Direct subordinates (nullptr if there are none), shared by versions until changed
+        std::shared_ptr<const std::vector<boost::uuids::uuid>> subordinates;
+    };
+
+    //!< Visitor of records
+    using Visitor = std::function<void(const boost::uuids::uuid&, const Record&)>;
+
+    class Editor;
+
+    RegistryVersion(const RegistryVersion& other)  = delete;
+    RegistryVersion(const RegistryVersion&& other) = delete;
+
+    RegistryVersion& operator=(const RegistryVersion& other)  = delete;
+    RegistryVersion& operator=(const RegistryVersion&& other) = delete;
+
+    /**
+     * @brief Construct empty version (version 0)
+     */
+    RegistryVersion();
+
+    /**
+     * @brief Get version of source data
+     */
+    uint64_t version() const;
+
+    /**
+     * @brief Get number of employees
+     */
+    uint32_t size() const;
+
+    /**
+     * @brief Find employee record
+     * @param id employee unique identifier
+     * @return record (nullptr if there is no such employee)
+     */
+    const Record* find(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Visit all records (in order of trie, not of hierarchy)
+     * @param visitor visitor of records
+     */
+    void for_each(const Visitor& visitor) const;
+
+private:
+    //!< Number of hash bits taken by every level of trie
+    static constexpr uint32_t LEVEL_BITS = 4;
+
+    //!< Number of children of every inner node
+    static constexpr uint32_t FANOUT = 1u << LEVEL_BITS;
+
+    //!< Number of levels of inner nodes (the last level refers to leaves)
+    static constexpr uint32_t DEPTH = 4;
+
+    /**
+     * @struct Node
+     * @brief Node of trie
+     */
+    struct Node {
+        uint64_t owner = 0; //!< Editor which copied node (may change it until publication)
+    };
+
+    /**
+     * @struct Branch
+     * @brief Inner node of trie
+     */
+    struct Branch : Node {
+        std::array<std::shared_ptr<Node>, FANOUT> children; //!< Branches or leaves (optional)
+    };
+
+    /**
+     * @struct Leaf
+     * @brief Leaf of trie with records of the same hash bits
+     */
+    struct Leaf : Node {
+        std::vector<std::pair<boost::uuids::uuid, Record>> records; //!< Records
+    };
+
+    /**
+     * @brief Construct published version
+     * @param version version of source data
+     * @param size number of employees
+     * @param root root of trie (nullptr for empty one)
+     */
+    RegistryVersion(uint64_t version, uint32_t size, std::shared_ptr<Node> root);
+
+    /**
+     * @brief Get hash of employee unique identifier (levels of trie take its bits from high ones)
+     */
+    static uint64_t hash(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Get index of child of inner node for hash
+     */
+    static uint32_t child_index(uint64_t hash, uint32_t level);
+
+    /**
+     * @brief Find record in trie
+     * @param root root of trie
+     * @param id employee unique identifier
+     * @return record (nullptr if there is no such employee)
+     */
+    static const Record* find(const Node* root, const boost::uuids::uuid& id);
+
+private:
+    uint64_t              version_; //!< Version of source data
+    uint32_t              size_;    //!< Number of employees
+    std::shared_ptr<Node> root_;    //!< Root of trie (never changed after publication)
+};
+
+/**
+ * @class RegistryVersion::Editor
+ * @brief Editor of the next version of registry
+ *
+ * Nodes copied by editor belong to it until publication, so batch of changes copies every node
+ * once. Base version is not changed.
+ */
+class RegistryVersion::Editor {
+public:
+    Editor() = delete;
+
+    Editor(const Editor& other)  = delete;
+    Editor(const Editor&& other) = delete;
+
+    Editor& operator=(const Editor& other)  = delete;
+    Editor& operator=(const Editor&& other) = delete;
+
+    /**
+     * @brief Construct editor
+     * @param base version the next one is based on
+     */
+    explicit Editor(const RegistryVersion& base);
+
+    /**
+     * @brief Find employee record in edited version
+     * @param id employee unique identifier
+     * @return record (nullptr if there is no such employee)
+     */
+    const Record* find(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Insert or replace employee record
+     * @param id employee unique identifier
+     * @param record record
+     */
+    void put(const boost::uuids::uuid& id, const Record& record);
+
+    /**
+     * @brief Remove employee record
+     * @param id employee unique identifier
+     * @return was removed or not
+     */
+    bool erase(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Publish edited version (further changes are made copy-on-write again)
+     * @param version version of source data
+     * @return published version
+     */
+    std::shared_ptr<const RegistryVersion> publish(uint64_t version);
+
+private:
+    /**
+     * @brief Get link to leaf of hash with all nodes on path owned by editor (nodes are copied
+     * or created)
+     * @param hash hash of employee unique identifier
+     * @return link to leaf
+     */
+    std::shared_ptr<Node>& own_leaf(uint64_t hash);
+
+private:
+    std::shared_ptr<Node> root_;  //!< Root of trie
+    uint32_t              size_;  //!< Number of employees
+    uint64_t              owner_; //!< Unique identifier of editor (see `Node::owner`)
+};
+
+} // namespace employee
@@ -1,13 +1,162 @@
 // relative includes
 #include "RelationManager.h"
 
+// boost includes
+#include <boost/unordered_set.hpp>
+
 // C++ includes
-#include <stack>
+#include <algorithm>
 
+using employee::EmployeeManagerStats;
+using employee::HierarchyTraversal;
 using employee::RelationManager;
 
 using uuid_t = boost::uuids::uuid;
 
+//! Registrate hierarchy node of employee
+void RelationManager::add_node(const uuid_t& id) {
+    TimedUniqueLock lock(mtx_, lock_stats_);
+
+    nodes_[id];
+    detach_labels(id);
+}
+
+//! Registrate hierarchy nodes of many employees at once
+void RelationManager::add_nodes(const std::vector<uuid_t>& ids) {
+    TimedUniqueLock lock(mtx_, lock_stats_);
+
+    nodes_.reserve(nodes_.size() + ids.size());
+
+    for (const uuid_t& id : ids) {
+        nodes_[id];
+        detach_labels(id);
+    }
+}
+
+//! Registrate hierarchy nodes of many employees together with their subordination relations
+void RelationManager::add_forest(const std::vector<uuid_t>&   ids,
+                                 const std::vector<uint32_t>& chiefs) {
+    TimedUniqueLock lock(mtx_, lock_stats_);
+
+    const size_t count = ids.size();
+
+    // 1.Nodes (addressed by indices from now on: nodes of boost::unordered_map are stable)
+    std::vector<Node*> nodes(count);
+
+    nodes_.reserve(nodes_.size() + count);
+    sub_to_chief_.reserve(sub_to_chief_.size() + count);
+
+    for (size_t i = 0; i < count; ++i) {
+        nodes[i] = &nodes_[ids[i]];
+
+        if (chiefs[i] != NONE) {
+            sub_to_chief_.emplace(ids[i], ids[chiefs[i]]);
+            ++nodes[chiefs[i]]->children_capacity;
+        }
+    }
+
+    // 2.Ranges of direct subordinates (appended to the end of array, exactly sized)
+    uint32_t offset = static_cast<uint32_t>(children_.size());
+    for (size_t i = 0; i < count; ++i) {
+        nodes[i]->children_offset = offset;
+        offset += nodes[i]->children_capacity;
+    }
+
+    children_.resize(offset);
+    for (size_t i = 0; i < count; ++i) {
+        if (chiefs[i] != NONE) {
+            Node& chief = *nodes[chiefs[i]];
+
+            nodes[i]->position                                        = chief.children_count;
+            children_[chief.children_offset + chief.children_count++] = ids[i];
+        }
+    }
+
+    // 3.Subtree sizes (reverse scan: all subordinates are done before chief)
+    for (size_t i = count; i > 0; --i) {
+        if (chiefs[i - 1] != NONE) {
+            nodes[chiefs[i - 1]]->subtree_size += nodes[i - 1]->subtree_size + 1;
+        }
+    }
+
+    // 4.Numbering (pre-order scan: every subtree takes the first free labels of its chief)
+    if (!labels_fresh_) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        Node&          node  = *nodes[i];
+        const uint64_t width = (node.subtree_size + 1) * LABELS_QUANTUM;
+
+        uint64_t first = 0;
+        if (chiefs[i] == NONE) {
+            if (LABELS_END - next_root_label_ < width) {
+                labels_fresh_ = false;
+                return;
+            }
+
+            first = next_root_label_;
+            next_root_label_ += width;
+        } else {
+            Node& chief = *nodes[chiefs[i]];
+
+            first = chief.next_free;
+            chief.next_free += width;
+        }
+
+        node.enter     = first;
+        node.exit      = first + width - 1;
+        node.next_free = first + 1;
+    }
+}
+
+//! Remove hierarchy node of employee together with all his relations
+void RelationManager::remove_node(const uuid_t& id) {
+    TimedUniqueLock lock(mtx_, lock_stats_);
+
+    auto node_it = nodes_.find(id);
+    if (node_it == nodes_.end()) {
+        return;
+    }
+
+    // 1.Relation with chief
+    auto subordinate_it = sub_to_chief_.find(id);
+    if (subordinate_it != sub_to_chief_.end()) {
+        const uuid_t id_chief = subordinate_it->second;
+
+        remove_child(nodes_[id_chief], id);
+
+        sub_to_chief_.erase(subordinate_it);
+        update_chiefs_sizes(id_chief, id, -1);
+    }
+
+    // 2.Relations with direct subordinates (their own subtrees stay the same)
+    Node& node = node_it->second;
+    for (uint32_t i = 0; i < node.children_count; ++i) {
+        sub_to_chief_.erase(children_[node.children_offset + i]);
+        detach_labels(children_[node.children_offset + i]);
+    }
+    release_children(node);
+
+    nodes_.erase(id);
+}
+
+//! Remove hierarchy node of employee only if he has neither chief nor subordinates
+bool RelationManager::remove_isolated_node(const uuid_t& id) {
+    TimedUniqueLock lock(mtx_, lock_stats_);
+
+    auto node_it = nodes_.find(id);
+    if (node_it == nodes_.end() || node_it->second.children_count != 0 ||
+        sub_to_chief_.count(id) != 0) {
+        return false;
+    }
+
+    release_children(node_it->second);
+    nodes_.erase(node_it);
+
+    return true;
+}
+
 //! Add subordination relation
 bool RelationManager::add_relation(const uuid_t& id_chief, const uuid_t& id) {
     // 1.Validation on self-subordination
@@ -15,7 +164,7 @@ bool RelationManager::add_relation(const uuid_t& id_chief, const uuid_t& id) {
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(mtx_);
+    TimedUniqueLock lock(mtx_, lock_stats_);
 
     // 2.Validate if we already have a subordinator with `id` identifier
     // Also we can skip reverse check due to consistency of containers
@@ -29,9 +178,92 @@ bool RelationManager::add_relation(const uuid_t& id_chief, const uuid_t& id) {
         return false;
     }
 
-    // 4.Add
+    // 4.Add (numbering is valid for registered nodes only)
+    if (nodes_.count(id_chief) == 0 || nodes_.count(id) == 0) {
+        labels_fresh_ = false;
+    }
+
+    Node& chief = nodes_[id_chief];
+
     sub_to_chief_[id] = id_chief;
-    chief_to_subs_.insert({id_chief, id});
+    append_child(chief, id);
+
+    update_chiefs_sizes(id_chief, id, +1);
+    attach_labels(chief, id);
+
+    return true;
+}
+
+//! Add many subordination relations at once
+bool RelationManager::add_relations(const std::vector<std::pair<uuid_t, uuid_t>>& relations) {
+    TimedUniqueLock lock(mtx_, lock_stats_);
+
+    // 1.Validate on self-subordination and on already having a chief (in registry or in batch)
+    boost::unordered_map<uuid_t, uuid_t> new_sub_to_chief;
+    new_sub_to_chief.reserve(relations.size());
+
+    for (const auto& [id_chief, id] : relations) {
+        if (id_chief == id || sub_to_chief_.count(id) != 0 ||
+            !new_sub_to_chief.emplace(id, id_chief).second) {
+            return false;
+        }
+    }
+
+    // 2.Validate on hierarchical cycle: walk chiefs chains through both old and new relations,
+    // every employee is passed only once (the rest of his chain is already checked)
+    enum class Mark : uint8_t { IN_PATH, CHECKED };
+    boost::unordered_map<uuid_t, Mark> marks;
+    std::vector<uuid_t>                path;
+
+    for (const auto& [id_chief, id] : relations) {
+        path.clear();
+
+        std::optional<uuid_t> current = id;
+        while (current) {
+            auto mark_it = marks.find(*current);
+            if (mark_it != marks.end()) {
+                if (mark_it->second == Mark::IN_PATH) {
+                    return false;
+                }
+                break;
+            }
+
+            marks.emplace(*current, Mark::IN_PATH);
+            path.push_back(*current);
+
+            auto new_it = new_sub_to_chief.find(*current);
+            auto old_it = sub_to_chief_.find(*current);
+
+            if (new_it != new_sub_to_chief.end()) {
+                current = new_it->second;
+            } else if (old_it != sub_to_chief_.end()) {
+                current = old_it->second;
+            } else {
+                current = std::nullopt;
+            }
+        }
+
+        for (const uuid_t& passed : path) {
+            marks[passed] = Mark::CHECKED;
+        }
+    }
+    record_traversal(HierarchyTraversal::CYCLE_CHECK, marks.size());
+
+    // 3.Add
+    std::vector<uuid_t> chiefs;
+    chiefs.reserve(relations.size());
+
+    sub_to_chief_.reserve(sub_to_chief_.size() + relations.size());
+    for (const auto& [id_chief, id] : relations) {
+        sub_to_chief_[id] = id_chief;
+        append_child(nodes_[id_chief], id);
+        chiefs.push_back(id_chief);
+    }
+
+    recalculate_chiefs_sizes(chiefs);
+
+    // Pay attention: the whole numbering is rebuilt once by the next query
+    labels_fresh_ = false;
 
     return true;
 }
@@ -43,7 +275,7 @@ bool RelationManager::remove_relation(const uuid_t& id_chief, const uuid_t& id)
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(mtx_);
+    TimedUniqueLock lock(mtx_, lock_stats_);
 
     // 2.Validate if we have a subordinator with `id` identifier with corresponging chief
     auto subordinate_it = sub_to_chief_.find(id);
@@ -52,29 +284,18 @@ bool RelationManager::remove_relation(const uuid_t& id_chief, const uuid_t& id)
     }
 
     // 3.Remove from containers
-    auto [begin, end] = chief_to_subs_.equal_range(id_chief);
-
-    bool found = false;
-    for (auto it = begin; it != end; ++it) {
-        if (it->second == id) {
-            chief_to_subs_.erase(it);
-            found = true;
-            break;
-        }
-    }
-
-    if (!found) {
-        return false;
-    }
-
+    remove_child(nodes_[id_chief], id);
     sub_to_chief_.erase(subordinate_it);
 
+    update_chiefs_sizes(id_chief, id, -1);
+    detach_labels(id);
+
     return true;
 }
 
 //! Find employee chief
 std::optional<uuid_t> RelationManager::get_chief(const uuid_t& id) const {
-    std::lock_guard<std::mutex> lock(mtx_);
+    TimedSharedLock lock(mtx_, lock_stats_);
 
     auto it = sub_to_chief_.find(id);
     if (it == sub_to_chief_.end()) {
@@ -84,80 +305,460 @@ std::optional<uuid_t> RelationManager::get_chief(const uuid_t& id) const {
     return it->second;
 }
 
-//! Get employee direct subordinates
-std::vector<uuid_t> RelationManager::get_direct_subordinates(const uuid_t& id) const {
-    std::lock_guard<std::mutex> lock(mtx_);
+//! Get chain of employee chiefs
+std::vector<uuid_t> RelationManager::get_all_chiefs(const uuid_t& id) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
 
-    auto it = chief_to_subs_.find(id);
-    if (it == chief_to_subs_.end()) {
-        return {};
+    std::vector<uuid_t> chiefs;
+
+    auto it = sub_to_chief_.find(id);
+    while (it != sub_to_chief_.end()) {
+        chiefs.push_back(it->second);
+        it = sub_to_chief_.find(it->second);
     }
+    record_traversal(HierarchyTraversal::CHIEFS, chiefs.size());
 
-    auto [begin, end] = chief_to_subs_.equal_range(id);
+    return chiefs;
+}
+
+//! Get employees together with union of their chiefs chains
+std::vector<uuid_t> RelationManager::get_all_chiefs(const std::vector<uuid_t>& ids) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
+
+    std::vector<uuid_t>          result;
+    boost::unordered_set<uuid_t> listed;
+
+    for (const uuid_t& id : ids) {
+        // The rest of chain is already listed by some previous employee
+        uuid_t current = id;
+        while (listed.insert(current).second) {
+            result.push_back(current);
+
+            auto it = sub_to_chief_.find(current);
+            if (it == sub_to_chief_.end()) {
+                break;
+            }
+
+            current = it->second;
+        }
+    }
+    record_traversal(HierarchyTraversal::CHIEFS, result.size());
 
-    std::vector<uuid_t> direct_subordinates;
-    direct_subordinates.reserve(std::distance(begin, end));
+    return result;
+}
+
+//! Check if employee is direct or indirect subordinate of chief
+bool RelationManager::is_subordinate(const uuid_t& id_chief, const uuid_t& id) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
 
-    while (begin != end) {
-        direct_subordinates.push_back(begin->second);
-        ++begin;
+    auto chief_it = nodes_.find(id_chief);
+    auto it       = nodes_.find(id);
+    if (chief_it == nodes_.end() || it == nodes_.end() || id_chief == id) {
+        return false;
     }
 
-    return direct_subordinates;
+    ensure_labels();
+
+    return chief_it->second.enter < it->second.enter && it->second.enter < chief_it->second.exit;
+}
+
+//! Get employee direct subordinates
+std::vector<uuid_t> RelationManager::get_direct_subordinates(const uuid_t& id) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
+
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
+        return {};
+    }
+
+    const uuid_t* begin = children_.data() + it->second.children_offset;
+    return std::vector<uuid_t>(begin, begin + it->second.children_count);
 }
 
 //! Get employee all subordinates
 std::vector<uuid_t> RelationManager::get_all_subordinates(const uuid_t& id) const {
-    std::lock_guard<std::mutex> lock(mtx_);
+    TimedSharedLock lock(mtx_, lock_stats_);
 
-    auto it = chief_to_subs_.find(id);
-    if (it == chief_to_subs_.end()) {
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
         return {};
     }
 
+    // Breadth-first walk: result itself is the queue, ranges of subordinates are appended as is
     std::vector<uuid_t> all_subordinates;
+    all_subordinates.reserve(it->second.subtree_size);
+
+    const Node* current = &it->second;
+    for (size_t i = 0;; ++i) {
+        const uuid_t* begin = children_.data() + current->children_offset;
+        all_subordinates.insert(all_subordinates.end(), begin, begin + current->children_count);
+
+        if (i == all_subordinates.size()) {
+            break;
+        }
+
+        current = &nodes_.find(all_subordinates[i])->second;
+    }
+    record_traversal(HierarchyTraversal::SUBORDINATES, all_subordinates.size());
+
+    return all_subordinates;
+}
+
+//! Visit employee direct subordinates
+void RelationManager::visit_direct_subordinates(const uuid_t& id, const Visitor& visitor) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
+
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
+        return;
+    }
+
+    const uuid_t* begin = children_.data() + it->second.children_offset;
+    std::for_each(begin, begin + it->second.children_count, visitor);
+}
+
+//! Visit employee all subordinates in pre-order
+void RelationManager::visit_all_subordinates(const uuid_t& id, const Visitor& visitor) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
+
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
+        return;
+    }
+
+    // Current employee and position of his next direct subordinate to visit
+    const uuid_t* current = &it->first;
+    const Node*   node    = &it->second;
+    uint32_t      next    = 0;
+    size_t        visited = 0;
+
+    while (true) {
+        // 1.Down to the next direct subordinate
+        if (next < node->children_count) {
+            current = &children_[node->children_offset + next];
+            visitor(*current);
+            ++visited;
+
+            node = &nodes_.find(*current)->second;
+            next = 0;
+            continue;
+        }
+
+        // 2.All subordinates are visited: up to the chief and his next direct subordinate
+        if (*current == id) {
+            break;
+        }
+
+        next    = node->position + 1;
+        current = &sub_to_chief_.find(*current)->second;
+        node    = &nodes_.find(*current)->second;
+    }
+    record_traversal(HierarchyTraversal::SUBORDINATES, visited);
+}
+
+//! Get all subordination relations
+std::vector<std::pair<uuid_t, uuid_t>> RelationManager::get_all_relations() const {
+    TimedSharedLock lock(mtx_, lock_stats_);
+
+    std::vector<std::pair<uuid_t, uuid_t>> relations;
+    relations.reserve(sub_to_chief_.size());
+
+    for (const auto& [subordinate, chief] : sub_to_chief_) {
+        relations.emplace_back(chief, subordinate);
+    }
+
+    return relations;
+}
+
+//! Get number of all employee subordinates
+size_t RelationManager::subtree_size(const uuid_t& id) const {
+    TimedSharedLock lock(mtx_, lock_stats_);
+
+    auto it = nodes_.find(id);
+    return it != nodes_.end() ? it->second.subtree_size : 0;
+}
+
+//! Read collected statistics of hierarchy lock and walks over hierarchy
+void RelationManager::read_stats(EmployeeManagerStats& stats) const {
+    stats.hierarchy_lock = lock_stats_.read();
+
+    for (size_t i = 0; i < HIERARCHY_TRAVERSALS_COUNT; ++i) {
+        stats.nodes_visited[i] = traversal_stats_[i].read();
+    }
+}
+
+//! Helper function for propagate subtree size change of `id` to all his chiefs
+void RelationManager::update_chiefs_sizes(const uuid_t& id_chief, const uuid_t& id, int sign) {
+    // 1.Subtree of `id` including himself
+    const size_t delta_size = nodes_[id].subtree_size + 1;
+
+    // 2.Walk only the chiefs chain
+    uuid_t current = id_chief;
+    size_t visited = 0;
+    while (true) {
+        size_t& size = nodes_[current].subtree_size;
+
+        size = (sign > 0) ? size + delta_size : size - delta_size;
+        ++visited;
+
+        auto it = sub_to_chief_.find(current);
+        if (it == sub_to_chief_.end()) {
+            break;
+        }
+
+        current = it->second;
+    }
+    record_traversal(HierarchyTraversal::CHIEFS, visited);
+}
+
+//! Helper function for recalculate subtree sizes of all chiefs of given employees bottom-up
+void RelationManager::recalculate_chiefs_sizes(const std::vector<uuid_t>& ids) {
+    // 1.Collect affected employees with number of their affected direct subordinates
+    boost::unordered_map<uuid_t, size_t> pending;
+
+    for (const uuid_t& id : ids) {
+        if (!pending.emplace(id, 0).second) {
+            continue;
+        }
+
+        uuid_t current = id;
+        while (true) {
+            auto it = sub_to_chief_.find(current);
+            if (it == sub_to_chief_.end()) {
+                break;
+            }
+
+            auto [chief_it, inserted] = pending.emplace(it->second, 0);
+            ++chief_it->second;
+
+            if (!inserted) {
+                break;
+            }
+            current = it->second;
+        }
+    }
+
+    record_traversal(HierarchyTraversal::CHIEFS, pending.size());
+
+    // 2.Recalculate employee right after all his affected subordinates
+    std::vector<uuid_t> ready;
+    for (const auto& [id, count] : pending) {
+        if (count == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    while (!ready.empty()) {
+        const uuid_t current = ready.back();
+        ready.pop_back();
+
+        Node&  node = nodes_[current];
+        size_t size = 0;
+
+        for (uint32_t i = 0; i < node.children_count; ++i) {
+            size += nodes_[children_[node.children_offset + i]].subtree_size + 1;
+        }
+
+        node.subtree_size = size;
+
+        auto it = sub_to_chief_.find(current);
+        if (it != sub_to_chief_.end() && --pending[it->second] == 0) {
+            ready.push_back(it->second);
+        }
+    }
+}
+
+//! Helper function for append subordinate to range of chief direct subordinates
+void RelationManager::append_child(Node& chief, const uuid_t& id) {
+    // 1.Range is full: extend it in place (if it is the last one) or move to the end
+    if (chief.children_count == chief.children_capacity) {
+        const uint32_t capacity = std::max<uint32_t>(4, 2 * chief.children_capacity);
+
+        if (chief.children_offset + chief.children_capacity == children_.size()) {
+            children_.resize(chief.children_offset + capacity);
+        } else {
+            const uint32_t offset = static_cast<uint32_t>(children_.size());
+
+            children_.resize(offset + capacity);
+            std::copy_n(children_.begin() + chief.children_offset, chief.children_count,
+                        children_.begin() + offset);
+
+            children_garbage_ += chief.children_capacity;
+            chief.children_offset = offset;
+        }
 
-    // dfs
-    std::stack<uuid_t> tower;
+        chief.children_capacity = capacity;
+    }
+
+    // 2.Append
+    nodes_[id].position = chief.children_count;
+    children_[chief.children_offset + chief.children_count++] = id;
+
+    compact_children();
+}
 
-    // 1.First step - direct subordinates
-    auto [begin, end] = chief_to_subs_.equal_range(id);
-    for (; begin != end; ++begin) {
-        tower.push(begin->second);
-        all_subordinates.push_back(begin->second);
+//! Helper function for remove subordinate from range of chief direct subordinates
+void RelationManager::remove_child(Node& chief, const uuid_t& id) {
+    const uint32_t position = nodes_[id].position;
+    const uint32_t last     = chief.children_offset + chief.children_count - 1;
+
+    if (chief.children_offset + position != last) {
+        children_[chief.children_offset + position] = children_[last];
+        nodes_[children_[last]].position            = position;
     }
 
-    // 2.Then - all subordinates of direct and so on (recursively)
+    --chief.children_count;
+}
+
+//! Helper function for release range of direct subordinates of removed node
+void RelationManager::release_children(Node& node) {
+    children_garbage_ += node.children_capacity;
+
+    node.children_count    = 0;
+    node.children_capacity = 0;
+
+    compact_children();
+}
+
+//! Helper function for compact all ranges of direct subordinates
+void RelationManager::compact_children() {
+    if (children_garbage_ < COMPACTION_THRESHOLD || 2 * children_garbage_ < children_.size()) {
+        return;
+    }
+
+    std::vector<uuid_t> compacted;
+    compacted.reserve(children_.size() - children_garbage_);
+
+    for (auto& [id, node] : nodes_) {
+        const uint32_t offset = static_cast<uint32_t>(compacted.size());
+
+        compacted.insert(compacted.end(), children_.begin() + node.children_offset,
+                         children_.begin() + node.children_offset + node.children_count);
+
+        node.children_offset   = offset;
+        node.children_capacity = node.children_count;
+    }
+
+    children_         = std::move(compacted);
+    children_garbage_ = 0;
+}
+
+//! Helper function for label subtree by Euler tour
+void RelationManager::label_subtree(const uuid_t& id, uint64_t begin, uint64_t unit) const {
+    std::vector<std::pair<const Node*, uint64_t>> tower{{&nodes_.find(id)->second, begin}};
+    size_t                                        visited = 0;
+
     while (!tower.empty()) {
-        const uuid_t& current = tower.top();
-        tower.pop();
+        const auto [node, first] = tower.back();
+        tower.pop_back();
+        ++visited;
+
+        // Subordinates subtrees follow the enter label, free labels are left before the exit one
+        node->enter     = first;
+        node->exit      = first + unit * (node->subtree_size + 1) - 1;
+        node->next_free = first + 1;
+
+        for (uint32_t i = 0; i < node->children_count; ++i) {
+            const Node& child = nodes_.find(children_[node->children_offset + i])->second;
 
-        auto [first, last] = chief_to_subs_.equal_range(current);
-        for (; first != last; ++first) {
-            tower.push(first->second);
-            all_subordinates.push_back(first->second);
+            tower.emplace_back(&child, node->next_free);
+            node->next_free += unit * (child.subtree_size + 1);
         }
     }
+    record_traversal(HierarchyTraversal::RELABEL, visited);
+}
 
-    return all_subordinates;
+//! Helper function for relabel subtree attached to chief
+void RelationManager::attach_labels(Node& chief, const uuid_t& id) {
+    if (!labels_fresh_) {
+        return;
+    }
+
+    // Take a half of chief free labels at most (the rest is for next subordinates)
+    const uint64_t count = nodes_[id].subtree_size + 1;
+    const uint64_t width = std::min((chief.exit - chief.next_free) / 2, count * LABELS_QUANTUM);
+    const uint64_t unit  = width / count;
+
+    if (unit < 2) {
+        labels_fresh_ = false;
+        return;
+    }
+
+    label_subtree(id, chief.next_free, unit);
+    chief.next_free += unit * count;
+}
+
+//! Helper function for relabel subtree which became top-level one
+void RelationManager::detach_labels(const uuid_t& id) {
+    if (!labels_fresh_) {
+        return;
+    }
+
+    const uint64_t width = (nodes_[id].subtree_size + 1) * LABELS_QUANTUM;
+
+    if (LABELS_END - next_root_label_ < width) {
+        labels_fresh_ = false;
+        return;
+    }
+
+    label_subtree(id, next_root_label_, LABELS_QUANTUM);
+    next_root_label_ += width;
+}
+
+//! Helper function for rebuild Euler tour numbering if it is stale
+void RelationManager::ensure_labels() const {
+    if (labels_fresh_) {
+        return;
+    }
+
+    // Only one reader rebuilds, others wait and use its result
+    std::lock_guard<std::mutex> lock(labels_mtx_);
+    if (labels_fresh_) {
+        return;
+    }
+
+    // Labels are evenly distributed among all employees
+    const uint64_t unit = REBUILT_LABELS_END / (nodes_.size() + 1);
+
+    uint64_t begin = 0;
+    for (const auto& [id, node] : nodes_) {
+        if (sub_to_chief_.count(id) == 0) {
+            label_subtree(id, begin, unit);
+            begin += unit * (node.subtree_size + 1);
+        }
+    }
+
+    next_root_label_ = REBUILT_LABELS_END;
+    labels_fresh_    = true;
 }
 
 //! Helper function for validate check if ids has hierarchical cycle
 bool RelationManager::has_hierarchical_cycle(const uuid_t& id_chief, const uuid_t& id) const {
-    uuid_t current = id_chief;
+    // 1.Subordinate must not be chief of his own chief (O(1) by actual numbering)
+    auto chief_it = nodes_.find(id_chief);
+    auto it       = nodes_.find(id);
 
-    while (true) {
-        if (current == id) {
-            return true;
-        }
+    if (labels_fresh_ && chief_it != nodes_.end() && it != nodes_.end()) {
+        const Node& chief = chief_it->second;
+        const Node& node  = it->second;
+
+        return id_chief == id || (node.enter < chief.enter && chief.enter < node.exit);
+    }
+
+    // 2.Walk over chiefs otherwise
+    uuid_t current = id_chief;
+    size_t visited = 1;
 
+    while (current != id) {
         auto it = sub_to_chief_.find(current);
         if (it == sub_to_chief_.end()) {
             break;
         }
 
         current = it->second;
+        ++visited;
     }
+    record_traversal(HierarchyTraversal::CYCLE_CHECK, visited);
 
-    return false;
+    return current == id;
 }
\ No newline at end of file
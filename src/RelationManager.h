@@ -1,11 +1,24 @@
 #pragma once
 
+// lib includes
+#include <employee_lib/EmployeeManagerStats.h>
+
 // boost includes
 #include <boost/unordered_map.hpp>
 #include <boost/uuid/uuid.hpp>
 
+// relative includes
+#include "Stats.h"
+
 // C++ includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
 
 namespace employee
 {
@@ -13,9 +26,65 @@ namespace employee
 /**
  * @class RelationManager
  * @brief Class responsible for work hierarchy and subordination relationship
+ *
+ * Direct subordinates of every chief are kept as a contiguous range of one flat array
+ * (CSR-like), so walk over subordinates is a linear memory scan. Range that runs out of capacity
+ * is moved to the end of array; holes left by moved and released ranges are removed by
+ * compaction.
+ *
+ * Hierarchy is also numbered by Euler tour: every employee has label interval [enter, exit],
+ * intervals of subordinates are nested into interval of their chief and intervals of other
+ * employees are disjoint. So "is subordinate" check is O(1). Labels are sparse: interval of
+ * employee keeps free space for new subordinates, so attached (or detached) subtree is just
+ * relabeled (O(subtree size)). When there is no free space left, numbering becomes stale and is
+ * rebuilt by the next query (meanwhile hierarchical cycles are checked by walk over chiefs).
  */
 class RelationManager {
 public:
+    //!< Index value for absent chief (see `add_forest`)
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    //!< Visitor of employees
+    using Visitor = std::function<void(const boost::uuids::uuid&)>;
+
+    /**
+     * @brief Registrate hierarchy node of employee (to take it into account in subtree sizes)
+     * @param id employee unique identifier
+     */
+    void add_node(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Registrate hierarchy nodes of many employees at once
+     * @param ids employees unique identifiers
+     */
+    void add_nodes(const std::vector<boost::uuids::uuid>& ids);
+
+    /**
+     * @brief Registrate hierarchy nodes of many employees together with their subordination
+     * relations at once (e.g. on load of saved hierarchy)
+     * Nodes are given in hierarchy pre-order, so relations are not validated and subtree sizes,
+     * ranges of direct subordinates and numbering are built by linear scans over indices.
+     * Attention! Nodes must not be registered yet and every chief must precede his subordinates.
+     * @param ids employees unique identifiers
+     * @param chiefs chiefs indices (`NONE` for top-level employee)
+     */
+    void add_forest(const std::vector<boost::uuids::uuid>& ids,
+                    const std::vector<uint32_t>&           chiefs);
+
+    /**
+     * @brief Remove hierarchy node of employee together with all his relations (with his chief
+     * and with his direct subordinates, who become top-level ones)
+     * @param id employee unique identifier
+     */
+    void remove_node(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Remove hierarchy node of employee only if he has neither chief nor subordinates
+     * @param id employee unique identifier
+     * @return was removed or not
+     */
+    bool remove_isolated_node(const boost::uuids::uuid& id);
+
     /**
      * @brief Add subordination relation
      * Attention! An employee cannot be his own chief.
@@ -29,6 +98,16 @@ public:
      */
     bool add_relation(const boost::uuids::uuid& id_chief, const boost::uuids::uuid& id);
 
+    /**
+     * @brief Add many subordination relations at once (all or nothing)
+     * The same rules as for `add_relation` are applied to the whole batch (including relations
+     * inside the batch itself); batch is validated and subtree sizes are updated in linear time.
+     * @param relations "chief-->subordinate" pairs
+     * @return were added or not
+     */
+    bool
+    add_relations(const std::vector<std::pair<boost::uuids::uuid, boost::uuids::uuid>>& relations);
+
     /**
      * @brief Remove subordination relation
      * @param id_chief chief unique identifier
@@ -44,6 +123,29 @@ public:
      */
     std::optional<boost::uuids::uuid> get_chief(const boost::uuids::uuid& id) const;
 
+    /**
+     * @brief Get chain of employee chiefs (from direct chief up to the top-level one)
+     * @param id employee unique identifier
+     * @return chiefs unique identifiers
+     */
+    std::vector<boost::uuids::uuid> get_all_chiefs(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get employees together with union of their chiefs chains (each one listed once)
+     * @param ids employees unique identifiers
+     * @return employees and chiefs unique identifiers
+     */
+    std::vector<boost::uuids::uuid>
+    get_all_chiefs(const std::vector<boost::uuids::uuid>& ids) const;
+
+    /**
+     * @brief Check if employee is direct or indirect subordinate of chief (O(1))
+     * @param id_chief chief unique identifier
+     * @param id employee unique identifier
+     * @return is subordinate or not
+     */
+    bool is_subordinate(const boost::uuids::uuid& id_chief, const boost::uuids::uuid& id) const;
+
     /**
      * @brief Get employee direct subordinates
      * @param id employee unique identifier
@@ -58,7 +160,145 @@ public:
      */
     std::vector<boost::uuids::uuid> get_all_subordinates(const boost::uuids::uuid& id) const;
 
+    /**
+     * @brief Visit employee direct subordinates (under shared lock)
+     * @param id employee unique identifier
+     * @param visitor visitor of every direct subordinate
+     */
+    void visit_direct_subordinates(const boost::uuids::uuid& id, const Visitor& visitor) const;
+
+    /**
+     * @brief Visit employee all subordinates in pre-order (under shared lock)
+     * Walk is done without any stack: down by ranges of direct subordinates, up by chiefs
+     * @param id employee unique identifier
+     * @param visitor visitor of every subordinate
+     */
+    void visit_all_subordinates(const boost::uuids::uuid& id, const Visitor& visitor) const;
+
+    /**
+     * @brief Get all subordination relations (consistent copy taken under single lock)
+     * @return "chief-->subordinate" pairs
+     */
+    std::vector<std::pair<boost::uuids::uuid, boost::uuids::uuid>> get_all_relations() const;
+
+    /**
+     * @brief Get number of all employee subordinates (O(1), without subtree traversal)
+     * @param id employee unique identifier
+     * @return number of all subordinates
+     */
+    size_t subtree_size(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Read collected statistics of hierarchy lock and walks over hierarchy
+     * @param stats statistics to fill (`hierarchy_lock` and `nodes_visited`)
+     */
+    void read_stats(EmployeeManagerStats& stats) const;
+
 private:
+    /**
+     * @struct Node
+     * @brief Hierarchy node data
+     */
+    struct Node {
+        size_t subtree_size = 0; //!< Number of all subordinates (maintained incrementally)
+
+        uint32_t children_offset   = 0; //!< Begin of direct subordinates range in `children_`
+        uint32_t children_count    = 0; //!< Number of direct subordinates
+        uint32_t children_capacity = 0; //!< Capacity of direct subordinates range
+        uint32_t position          = 0; //!< Position in range of chief direct subordinates
+
+        mutable uint64_t enter     = 0; //!< Euler tour label of subtree begin
+        mutable uint64_t exit      = 0; //!< Euler tour label of subtree end
+        mutable uint64_t next_free = 0; //!< The first label free for new subordinate subtree
+    };
+
+    //!< End of Euler tour labels space for rebuild (the rest is for new top-level employees)
+    static constexpr uint64_t REBUILT_LABELS_END = uint64_t{1} << 62;
+
+    //!< End of Euler tour labels space
+    static constexpr uint64_t LABELS_END = uint64_t{1} << 63;
+
+    //!< Number of labels per employee of new top-level subtree
+    static constexpr uint64_t LABELS_QUANTUM = uint64_t{1} << 24;
+
+    //!< Minimal number of garbage elements in `children_` to start compaction
+    static constexpr size_t COMPACTION_THRESHOLD = 1024;
+
+    /**
+     * @brief Helper function for propagate subtree size change of `id` to all his chiefs
+     * (O(depth))
+     * @param id_chief the nearest affected chief
+     * @param id root of added (or removed) subtree
+     * @param sign +1 for added subtree and -1 for removed one
+     */
+    void update_chiefs_sizes(const boost::uuids::uuid& id_chief,
+                             const boost::uuids::uuid& id,
+                             int                       sign);
+
+    /**
+     * @brief Helper function for recalculate subtree sizes of all chiefs of given employees
+     * bottom-up (each affected size is recalculated once by his direct subordinates)
+     * @param ids the nearest affected chiefs
+     */
+    void recalculate_chiefs_sizes(const std::vector<boost::uuids::uuid>& ids);
+
+    /**
+     * @brief Helper function for append subordinate to range of chief direct subordinates
+     * @param chief chief node
+     * @param id subordinate unique identifier
+     */
+    void append_child(Node& chief, const boost::uuids::uuid& id);
+
+    /**
+     * @brief Helper function for remove subordinate from range of chief direct subordinates
+     * (O(1): the last one is moved to the hole)
+     * @param chief chief node
+     * @param id subordinate unique identifier
+     */
+    void remove_child(Node& chief, const boost::uuids::uuid& id);
+
+    /**
+     * @brief Helper function for release range of direct subordinates of removed node
+     * @param node node
+     */
+    void release_children(Node& node);
+
+    /**
+     * @brief Helper function for compact all ranges of direct subordinates (if there is too
+     * much garbage in `children_`)
+     */
+    void compact_children();
+
+    /**
+     * @brief Helper function for label subtree by Euler tour
+     * Every employee gets `unit` labels for himself and labels of his subordinates
+     * @param id root of subtree
+     * @param begin the first label of subtree
+     * @param unit number of labels per employee
+     */
+    void label_subtree(const boost::uuids::uuid& id, uint64_t begin, uint64_t unit) const;
+
+    /**
+     * @brief Helper function for relabel subtree attached to chief (numbering becomes stale if
+     * there is no free labels)
+     * @param chief chief node
+     * @param id root of attached subtree
+     */
+    void attach_labels(Node& chief, const boost::uuids::uuid& id);
+
+    /**
+     * @brief Helper function for relabel subtree which became top-level one (numbering becomes
+     * stale if there is no free labels)
+     * @param id root of detached subtree
+     */
+    void detach_labels(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Helper function for rebuild Euler tour numbering if it is stale
+     * Attention! At least shared lock of `mtx_` must be held by the caller
+     */
+    void ensure_labels() const;
+
     /**
      * @brief Helper function for validate check if ids has hierarchical cycle
      * @return has cycle or not
@@ -66,15 +306,45 @@ private:
     bool has_hierarchical_cycle(const boost::uuids::uuid& id_chief,
                                 const boost::uuids::uuid& id) const;
 
+    /**
+     * @brief Helper function for record number of nodes visited by walk over hierarchy
+     * @param traversal walk over hierarchy
+     * @param nodes number of visited nodes
+     */
+    void record_traversal(HierarchyTraversal traversal, size_t nodes) const {
+        traversal_stats_[static_cast<size_t>(traversal)].record(nodes);
+    }
+
 private:
-    //!< Mutex for threads sync
-    mutable std::mutex mtx_;
+    //!< Mutex for threads sync (shared for readers, unique for writers)
+    mutable std::shared_mutex mtx_;
 
     //!< Relation "subordinate-->chief" (one to one)
     boost::unordered_map<boost::uuids::uuid, boost::uuids::uuid> sub_to_chief_;
 
-    //!< Relation "chief--subordinates>" (one to many)
-    boost::unordered_multimap<boost::uuids::uuid, boost::uuids::uuid> chief_to_subs_;
+    //!< Ranges of direct subordinates of all chiefs (see `Node`)
+    std::vector<boost::uuids::uuid> children_;
+
+    //!< Number of elements of `children_` not used by any range
+    size_t children_garbage_ = 0;
+
+    //!< Euler tour numbering is actual (set by writers or by rebuild under `labels_mtx_`)
+    mutable std::atomic<bool> labels_fresh_{true};
+
+    //!< Serializes rebuilds of Euler tour numbering by readers
+    mutable std::mutex labels_mtx_;
+
+    //!< The first label free for new top-level subtree
+    mutable uint64_t next_root_label_ = 0;
+
+    //!< Hierarchy nodes with their subtree sizes
+    boost::unordered_map<boost::uuids::uuid, Node> nodes_;
+
+    //!< Statistics of `mtx_`
+    mutable LockRecorder lock_stats_;
+
+    //!< Numbers of nodes visited by every walk over hierarchy
+    mutable std::array<HistogramRecorder, HIERARCHY_TRAVERSALS_COUNT> traversal_stats_;
 };
 
 } // namespace employee
\ No newline at end of file
@@ -1,135 +1,878 @@
 // relative includes
 #include "SalaryCalculator.h"
-#include "Employee.h"
-#include "RelationManager.h"
+#include "SalaryRules.h"
+#include "SeniorityKernel.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+
+// C++ includes
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <mutex>
 
 using namespace employee;
 
+using uuid_t = boost::uuids::uuid;
+
 //! Contruct salary calculator entity
-SalaryCalculator::SalaryCalculator(const boost::unordered_map<uuid_t, Employee*>& storage,
-                                   const RelationManager&                         relation_mgr) :
-    employees_(storage), relation_manager_(relation_mgr) {}
+SalaryCalculator::SalaryCalculator(ThreadPool* pool, const std::optional<SalaryPolicy>& policy) :
+    pool_(pool), policy_(policy) {}
+
+//! Memoize calculated salary entries
+void SalaryCalculator::memoize_all(const CalculatedEntries& entries,
+                                   month_t                  month,
+                                   uint64_t                 version) const {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+
+    for (const auto& [id, entry] : entries) {
+        memoize(id, month, version, entry);
+    }
+}
+
+//! Call body with salary rules of policy
+template<typename Body>
+decltype(auto) SalaryCalculator::with_rules(Body&& body) const {
+    if (policy_) {
+        return body(TableSalaryRules(*policy_));
+    }
+
+    return body(BuiltinSalaryRules{});
+}
 
 //! Calculate month salary of specific employee
-std::pair<double, bool> SalaryCalculator::calculate_month_salary(const uuid_t& id,
-                                                                 const date_t& date) const {
-    // Be calm and sure: employees_ container locked by the calling party (one level above)
-    auto employee_it = employees_.find(id);
-    assert(employee_it != employees_.end());
+std::pair<double, bool> SalaryCalculator::calculate_month_salary(const Snapshot& snapshot,
+                                                                 const uuid_t&   id,
+                                                                 month_t         month) const {
+    const std::optional<uint32_t> index = snapshot.find(id);
+    if (!index) {
+        return {0.0, false};
+    }
 
-    const Employee* p_employee = employee_it->second;
-    assert(p_employee != nullptr);
+    // 1.Fast path: already memoized (concurrent readers do not block each other)
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
 
-    switch (p_employee->get_type()) {
-        case EmployeeType::WORKER:
-            return calculate_worker_salary(p_employee, date);
+        if (const SalaryEntry* p_entry = find_memoized(id, month, snapshot.version());
+            p_entry != nullptr) {
+            return {p_entry->salary, p_entry->ok};
+        }
+    }
 
-        case EmployeeType::FOREMAN:
-            return calculate_foreman_salary(p_employee, date);
+    // 2.Large subtree: calculate it in parallel (no lock is held during calculation)
+    if (pool_ != nullptr && snapshot.subtree_end(*index) - *index >= PARALLEL_GRAIN) {
+        const SalaryEntry entry = with_rules([&](const auto& rules) {
+            return calculate_subtree_entry(rules, snapshot, *index, month);
+        });
 
-        case EmployeeType::MANAGER:
-            return calculate_manager_salary(p_employee, date);
+        std::unique_lock<std::shared_mutex> lock(mtx_);
+        memoize(id, month, snapshot.version(), entry);
 
-        default:
-            break;
+        return {entry.salary, entry.ok};
     }
 
-    return {0.0, false};
-}
+    // 3.Calculate missing entries (memoized ones are only read), then memoize them at once
+    CalculatedEntries calculated;
 
-//! Calculate month salary of worker and success flag
-std::pair<double, bool> SalaryCalculator::calculate_worker_salary(const Employee* p_obj,
-                                                                  const date_t&   date) const {
-    const date_t& hire_date   = p_obj->get_hire_date();
-    const double  base_salary = p_obj->get_base_salary();
+    const SalaryEntry entry = with_rules([&](const auto& rules) {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        return calculate_entry(rules, snapshot, *index, month, calculated);
+    });
 
-    // 1.Simple validation
-    const date_t hire_date_normalized{hire_date.year(), hire_date.month(), 1};
-    const date_t date_normalized{date.year(), date.month(), 1};
+    memoize_all(calculated, month, snapshot.version());
+
+    return {entry.salary, entry.ok};
+}
 
-    if (date_normalized < hire_date_normalized) {
+//! Calculate month salary of specific employee over registry version
+std::pair<double, bool> SalaryCalculator::calculate_month_salary(const RegistryVersion& registry,
+                                                                 const uuid_t&          id,
+                                                                 month_t month) const {
+    const RegistryVersion::Record* p_record = registry.find(id);
+    if (p_record == nullptr) {
         return {0.0, false};
     }
 
-    // 2.Bonus calculation
-    const int months_diff = 12 * (date_normalized.year() - hire_date_normalized.year()) +
-                            (date_normalized.month() - hire_date_normalized.month());
+    // 1.Fast path: already memoized
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
 
-    const int full_years = months_diff / 12;
+        if (const SalaryEntry* p_entry = find_memoized(id, month, registry.version());
+            p_entry != nullptr) {
+            return {p_entry->salary, p_entry->ok};
+        }
+    }
 
-    const double bonus = std::min(base_salary, 0.1 * full_years * base_salary);
+    // 2.Calculate missing entries
+    const SalaryEntry entry = with_rules([&](const auto& rules) {
+        return calculate_registry_entry(rules, registry, id, *p_record, month);
+    });
 
-    return {base_salary + bonus, true};
+    return {entry.salary, entry.ok};
 }
 
-//! Calculate month salary of foreman
-std::pair<double, bool> SalaryCalculator::calculate_foreman_salary(const Employee* p_obj,
-                                                                   const date_t&   date) const {
-    const date_t& hire_date   = p_obj->get_hire_date();
-    const double  base_salary = p_obj->get_base_salary();
+//! Calculate total month salary of all employees in a single bottom-up pass
+std::pair<double, bool> SalaryCalculator::calculate_total_salary(const Snapshot& snapshot,
+                                                                 month_t         month) const {
+    return calculate_total_salaries(snapshot, std::vector<month_t>{month}).front();
+}
 
-    // 1.Simple validation
-    const date_t hire_date_normalized{hire_date.year(), hire_date.month(), 1};
-    const date_t date_normalized{date.year(), date.month(), 1};
+//! Calculate total month salary of all employees for a batch of months
+std::vector<std::pair<double, bool>>
+SalaryCalculator::calculate_total_salaries(const Snapshot&             snapshot,
+                                           const std::vector<month_t>& months) const {
+    const uint32_t count = snapshot.size();
 
-    if (date_normalized < hire_date_normalized) {
-        return {0.0, false};
+    // 1.Buffers reused for all months
+    std::vector<double>      own_salaries(count);
+    std::vector<uint8_t>     hired(count);
+    std::vector<SalaryEntry> entries(count);
+
+    std::vector<std::pair<double, bool>> totals;
+    totals.reserve(months.size());
+
+    // 2.All salary entries and their total sum for every month
+    for (month_t month : months) {
+        with_rules([&](const auto& rules) {
+            calculate_all_entries(rules, snapshot, month, own_salaries, hired, entries);
+        });
+
+        const PayrollSums sums = sum_entries(snapshot, entries);
+        totals.emplace_back(sums.ok ? sums.total : 0.0, sums.ok);
+    }
+
+    return totals;
+}
+
+//! Calculate total month salary and headcount of every employee category in a single pass
+std::pair<PayrollByType, bool> SalaryCalculator::calculate_payroll_by_type(const Snapshot& snapshot,
+                                                                          month_t month) const {
+    const uint32_t count = snapshot.size();
+
+    // 1.All salary entries (foremen and managers bonuses reuse sums of their subordinates)
+    std::vector<double>      own_salaries(count);
+    std::vector<uint8_t>     hired(count);
+    std::vector<SalaryEntry> entries(count);
+
+    with_rules([&](const auto& rules) {
+        calculate_all_entries(rules, snapshot, month, own_salaries, hired, entries);
+    });
+
+    // 2.Sums by categories (totals are not valid if any salary was not calculated)
+    PayrollSums sums = sum_entries(snapshot, entries);
+    if (!sums.ok) {
+        for (CategoryPayroll& category : sums.by_type.categories) {
+            category.total = 0.0;
+        }
+    }
+
+    return {sums.by_type, sums.ok};
+}
+
+//! Calculate month salaries of specific employee for a range of months
+std::vector<std::pair<double, bool>>
+SalaryCalculator::calculate_salary_series(const Snapshot& snapshot,
+                                          const uuid_t&   id,
+                                          month_t         first,
+                                          month_t         last) const {
+    if (first > last) {
+        return {};
+    }
+
+    const std::optional<uint32_t> index = snapshot.find(id);
+    if (!index) {
+        return std::vector<std::pair<double, bool>>(last - first + 1, {0.0, false});
+    }
+
+    const uint32_t end = snapshot.subtree_end(*index);
+
+    std::vector<double> values;
+    month_t             required = 0;
+
+    with_rules([&](const auto& rules) {
+        // 1.Salary of employee is weighted sum of salaries with seniority bonus only of his
+        // subtree
+        const std::vector<double> weights = calculate_weights(rules, snapshot, *index, end, 0.0);
+        values = calculate_weighted_series(rules, snapshot, *index, weights, first, last);
+
+        // 2.Salary is calculated since all employees it depends on are hired
+        required = calculate_required_months(rules, snapshot, *index, end).front();
+    });
+
+    std::vector<std::pair<double, bool>> series;
+    series.reserve(values.size());
+
+    for (month_t month = first; month <= last; ++month) {
+        const bool ok = (month >= required);
+        series.emplace_back(ok ? values[month - first] : 0.0, ok);
+    }
+
+    return series;
+}
+
+//! Calculate total month salary of all employees for a range of months
+std::vector<std::pair<double, bool>>
+SalaryCalculator::calculate_total_salary_series(const Snapshot& snapshot,
+                                                month_t         first,
+                                                month_t         last) const {
+    if (first > last) {
+        return {};
     }
 
-    // 2.Bonus calculation (for long service)
-    const int months_diff = 12 * (date_normalized.year() - hire_date_normalized.year()) +
-                            (date_normalized.month() - hire_date_normalized.month());
+    const uint32_t count = snapshot.size();
+
+    std::vector<double>  values;
+    std::vector<month_t> required_months;
+
+    with_rules([&](const auto& rules) {
+        // 1.Total salary is weighted sum of salaries with seniority bonus only of all employees
+        const std::vector<double> weights = calculate_weights(rules, snapshot, 0, count, 1.0);
+        values = calculate_weighted_series(rules, snapshot, 0, weights, first, last);
+
+        // 2.Total salary is calculated since salaries of all employees are calculated
+        required_months = calculate_required_months(rules, snapshot, 0, count);
+    });
 
-    const int full_years = months_diff / 12;
+    const month_t required =
+        required_months.empty()
+            ? std::numeric_limits<month_t>::min()
+            : *std::max_element(required_months.begin(), required_months.end());
 
-    const double bonus_years = std::min(base_salary * 0.4, 0.05 * full_years * base_salary);
+    std::vector<std::pair<double, bool>> series;
+    series.reserve(values.size());
 
-    // 3.Bonus calculation (for direct subordinates)
-    const std::vector<uuid_t> direct_subordinates =
-        relation_manager_.get_direct_subordinates(p_obj->get_id());
+    for (month_t month = first; month <= last; ++month) {
+        const bool ok = (month >= required);
+        series.emplace_back(ok ? values[month - first] : 0.0, ok);
+    }
+
+    return series;
+}
 
-    double subordinates_total_salary = 0.0;
-    for (const uuid_t& subordinate_id : direct_subordinates) {
-        const auto [salary, ok] = calculate_month_salary(subordinate_id, date);
-        if (!ok) {
-            return {0.0, false};
+//! Drop memoized salaries of employees (for all months)
+void SalaryCalculator::invalidate(const std::vector<uuid_t>& ids, uint64_t version) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+
+    for (const uuid_t& id : ids) {
+        changed_versions_[id] = version;
+        salaries_.erase(id);
+    }
+}
+
+//! Forget removed employee
+void SalaryCalculator::forget(const uuid_t& id, uint64_t version) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+
+    changed_versions_.erase(id);
+    salaries_.erase(id);
+    forgotten_version_ = std::max(forgotten_version_, version);
+}
+
+//! Find memoized salary entry valid for snapshot version
+const SalaryCalculator::SalaryEntry*
+SalaryCalculator::find_memoized(const uuid_t& id, month_t month, uint64_t version) const {
+    auto it = salaries_.find(id);
+    if (it == salaries_.end()) {
+        return nullptr;
+    }
+
+    const std::vector<MemoEntry>& entries = it->second.entries;
+
+    auto memo_it = std::find_if(entries.begin(), entries.end(),
+                                [month](const MemoEntry& memo) { return memo.month == month; });
+    if (memo_it == entries.end()) {
+        return nullptr;
+    }
+
+    // Entry is valid if employee subtree was not changed between both versions (entry could be
+    // calculated by older or newer snapshot than requested one)
+    auto           changed_it = changed_versions_.find(id);
+    const uint64_t changed    = (changed_it != changed_versions_.end()) ? changed_it->second : 0;
+
+    if (changed > std::min(version, memo_it->version)) {
+        return nullptr;
+    }
+
+    return &memo_it->entry;
+}
+
+//! Memoize salary entry
+void SalaryCalculator::memoize(const uuid_t&      id,
+                               month_t            month,
+                               uint64_t           version,
+                               const SalaryEntry& entry) const {
+    // Pay attention: snapshot older than forgetting may still have forgotten employee, whose
+    // entry would be taken as valid for employee registered later with the same identifier
+    if (version < forgotten_version_ && changed_versions_.count(id) == 0) {
+        return;
+    }
+
+    MemoMonths&             months  = salaries_[id];
+    std::vector<MemoEntry>& entries = months.entries;
+
+    auto memo_it = std::find_if(entries.begin(), entries.end(),
+                                [month](const MemoEntry& memo) { return memo.month == month; });
+    if (memo_it != entries.end()) {
+        if (memo_it->version <= version) {
+            *memo_it = MemoEntry{entry, version, month};
         }
-        subordinates_total_salary += salary;
+        return;
     }
 
-    subordinates_total_salary *= 0.07;
+    // New month: buffer grows up to its limit, then the oldest memoized month is replaced
+    if (entries.size() < MEMO_MONTHS) {
+        entries.push_back(MemoEntry{entry, version, month});
+        return;
+    }
 
-    return {base_salary + bonus_years + subordinates_total_salary, true};
+    entries[months.next] = MemoEntry{entry, version, month};
+    months.next          = (months.next + 1) % MEMO_MONTHS;
 }
 
-//! Calculate month salary of manager
-std::pair<double, bool> SalaryCalculator::calculate_manager_salary(const Employee* p_obj,
-                                                                   const date_t&   date) const {
-    const date_t& hire_date   = p_obj->get_hire_date();
-    const double  base_salary = p_obj->get_base_salary();
+//! Calculate salary entry of employee
+template<typename Rules>
+SalaryCalculator::SalaryEntry
+SalaryCalculator::calculate_entry(const Rules&       rules,
+                                  const Snapshot&    snapshot,
+                                  uint32_t           index,
+                                  month_t            month,
+                                  CalculatedEntries& calculated) const {
+    const uint64_t version = snapshot.version();
+
+    //!< Post-order traversal frame
+    struct Frame {
+        uint32_t    index; //!< Employee index
+        uint32_t    next;  //!< Index of next direct subordinate
+        SalaryEntry entry; //!< Salary entry with subordinates sums
+    };
+
+    std::vector<Frame> tower;
+    tower.push_back({index, index + 1, {}});
+
+    SalaryEntry result;
+    while (!tower.empty()) {
+        Frame& frame = tower.back();
+
+        // 1.Next direct subordinate: reuse memoized entry or go down to his subtree
+        if (frame.next < snapshot.subtree_end(frame.index)) {
+            const uint32_t subordinate = frame.next;
+            frame.next                 = snapshot.subtree_end(subordinate);
+
+            const SalaryEntry* p_entry = find_memoized(snapshot.id(subordinate), month, version);
+            if (p_entry != nullptr) {
+                accumulate_entry(frame.entry, *p_entry);
+            } else {
+                tower.push_back({subordinate, subordinate + 1, {}});
+            }
+            continue;
+        }
 
-    // 1.Simple validation
-    const date_t hire_date_normalized{hire_date.year(), hire_date.month(), 1};
-    const date_t date_normalized{date.year(), date.month(), 1};
+        // 2.All direct subordinates are summed up: calculate
+        const EmployeeType type       = snapshot.type(frame.index);
+        const month_t      hire_month = snapshot.hire_month(frame.index);
+        const auto [rate, cap]        = seniority_coefficients(rules, type);
 
-    if (date_normalized < hire_date_normalized) {
-        return {0.0, false};
+        const double own_salary =
+            (month >= hire_month)
+                ? seniority_salary(snapshot.base_salary(frame.index), rate, cap,
+                                   (month - hire_month) / 12)
+                : 0.0;
+
+        complete_entry(rules, type, own_salary, month >= hire_month, frame.entry);
+        result = frame.entry;
+
+        calculated.emplace_back(snapshot.id(frame.index), result);
+
+        tower.pop_back();
+        if (!tower.empty()) {
+            accumulate_entry(tower.back().entry, result);
+        }
+    }
+
+    return result;
+}
+
+//! Calculate salary entry of employee over registry version and memoize it
+template<typename Rules>
+SalaryCalculator::SalaryEntry
+SalaryCalculator::calculate_registry_entry(const Rules&                   rules,
+                                           const RegistryVersion&         registry,
+                                           const uuid_t&                  id,
+                                           const RegistryVersion::Record& record,
+                                           month_t                        month) const {
+    const uint64_t version = registry.version();
+
+    const auto own_salary = [&rules, month](const RegistryVersion::Record& employee) {
+        const auto [rate, cap] = seniority_coefficients(rules, employee.type);
+
+        return (month >= employee.hire_month)
+                   ? seniority_salary(employee.base_salary, rate, cap,
+                                      (month - employee.hire_month) / 12)
+                   : 0.0;
+    };
+
+    // 1.Large subtree: subtrees of direct subordinates in parallel, then employee by them (in
+    // order of subordinates, so result does not depend on number of threads and on scheduling)
+    if (pool_ != nullptr && record.subtree_size >= PARALLEL_GRAIN) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mtx_);
+
+            if (const SalaryEntry* p_entry = find_memoized(id, month, version);
+                p_entry != nullptr) {
+                return *p_entry;
+            }
+        }
+
+        const std::vector<uuid_t>& subordinates = *record.subordinates;
+        std::vector<SalaryEntry>   entries(subordinates.size());
+
+        parallel_for(subordinates.size(), [&](size_t k) {
+            entries[k] = calculate_registry_entry(rules, registry, subordinates[k],
+                                                  *registry.find(subordinates[k]), month);
+        });
+
+        SalaryEntry entry;
+        for (const SalaryEntry& subordinate : entries) {
+            accumulate_entry(entry, subordinate);
+        }
+        complete_entry(rules, record.type, own_salary(record), month >= record.hire_month, entry);
+
+        memoize_all({{id, entry}}, month, version);
+
+        return entry;
+    }
+
+    //!< Post-order traversal frame
+    struct Frame {
+        const uuid_t*                  id;     //!< Employee identifier
+        const RegistryVersion::Record* record; //!< Employee record
+        size_t                         next;   //!< Position of next direct subordinate
+        SalaryEntry                    entry;  //!< Salary entry with subordinates sums
+    };
+
+    // 2.Post-order traversal: memoized entries are only read (lock is released periodically, so
+    // writers are not blocked by the whole subtree), calculated ones are memoized at once
+    CalculatedEntries calculated;
+    SalaryEntry       result;
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+
+        std::vector<Frame> tower;
+        tower.push_back({&id, &record, 0, {}});
+
+        uint32_t visited = 0;
+        while (!tower.empty()) {
+            Frame&                     frame        = tower.back();
+            const std::vector<uuid_t>* subordinates = frame.record->subordinates.get();
+
+            // 2.1.Next direct subordinate: reuse memoized entry or go down to his subtree
+            if (subordinates != nullptr && frame.next < subordinates->size()) {
+                const uuid_t& subordinate = (*subordinates)[frame.next++];
+
+                if (++visited % MEMO_LOCK_GRAIN == 0) {
+                    lock.unlock();
+                    lock.lock();
+                }
+
+                const SalaryEntry* p_entry = find_memoized(subordinate, month, version);
+                if (p_entry != nullptr) {
+                    accumulate_entry(frame.entry, *p_entry);
+                } else {
+                    tower.push_back({&subordinate, registry.find(subordinate), 0, {}});
+                }
+                continue;
+            }
+
+            // 2.2.All direct subordinates are summed up: calculate
+            const RegistryVersion::Record& employee = *frame.record;
+
+            complete_entry(rules, employee.type, own_salary(employee),
+                           month >= employee.hire_month, frame.entry);
+            result = frame.entry;
+
+            calculated.emplace_back(*frame.id, result);
+
+            tower.pop_back();
+            if (!tower.empty()) {
+                accumulate_entry(tower.back().entry, result);
+            }
+        }
+    }
+
+    memoize_all(calculated, month, version);
+
+    return result;
+}
+
+//! Calculate salary entry of employee by whole subtree calculation
+template<typename Rules>
+SalaryCalculator::SalaryEntry
+SalaryCalculator::calculate_subtree_entry(const Rules&    rules,
+                                          const Snapshot& snapshot,
+                                          uint32_t        index,
+                                          month_t         month) const {
+    const uint32_t end   = snapshot.subtree_end(index);
+    const uint32_t count = end - index;
+
+    std::vector<double>      own_salaries(count);
+    std::vector<uint8_t>     hired(count);
+    std::vector<SalaryEntry> entries(count);
+
+    calculate_own_salaries(rules, snapshot, index, end, month, own_salaries.data(), hired.data());
+    calculate_range(rules, snapshot, index, index, end, own_salaries.data(), hired.data(),
+                    entries.data());
+
+    return entries.front();
+}
+
+//! Calculate salaries with seniority bonus only for snapshot range
+template<typename Rules>
+void SalaryCalculator::calculate_own_salaries(const Rules&    rules,
+                                              const Snapshot& snapshot,
+                                              uint32_t        begin,
+                                              uint32_t        end,
+                                              month_t         month,
+                                              double*         own_salaries,
+                                              uint8_t*        hired) const {
+    const size_t chunks = (end - begin + OWN_SALARIES_CHUNK - 1) / OWN_SALARIES_CHUNK;
+
+    parallel_for(chunks, [&](size_t k) {
+        const uint32_t first = begin + static_cast<uint32_t>(k * OWN_SALARIES_CHUNK);
+        const uint32_t last  = std::min(end, first + OWN_SALARIES_CHUNK);
+
+        // Seniority coefficients columns of chunk
+        std::array<double, OWN_SALARIES_CHUNK> rates;
+        std::array<double, OWN_SALARIES_CHUNK> caps;
+
+        for (uint32_t i = first; i < last; ++i) {
+            std::tie(rates[i - first], caps[i - first]) =
+                seniority_coefficients(rules, snapshot.type(i));
+        }
+
+        calculate_seniority_salaries(last - first, snapshot.hire_months() + first,
+                                     snapshot.base_salaries() + first, rates.data(),
+                                     caps.data(), month, own_salaries + (first - begin),
+                                     hired + (first - begin));
+    });
+}
+
+//! Calculate salary entries of all employees of snapshot range
+template<typename Rules>
+void SalaryCalculator::calculate_range(const Rules&    rules,
+                                       const Snapshot& snapshot,
+                                       uint32_t        base,
+                                       uint32_t        begin,
+                                       uint32_t        end,
+                                       const double*   own_salaries,
+                                       const uint8_t*  hired,
+                                       SalaryEntry*    entries) const {
+    // 1.Small range: reverse scan of pre-order (all subordinates are calculated before chief)
+    if (pool_ == nullptr || end - begin < PARALLEL_GRAIN) {
+        for (uint32_t i = end; i > begin; --i) {
+            SalaryEntry& entry = entries[i - 1 - base];
+
+            complete_entry(rules, snapshot.type(i - 1), own_salaries[i - 1 - base],
+                           hired[i - 1 - base], entry);
+
+            const uint32_t chief = snapshot.chief(i - 1);
+            if (chief != Snapshot::NONE && chief >= begin) {
+                accumulate_entry(entries[chief - base], entry);
+            }
+        }
+        return;
+    }
+
+    // 2.Large range: split it into parts, every part is either one subtree or a few small ones
+    std::vector<std::pair<uint32_t, uint32_t>> parts;
+    for (uint32_t i = begin; i < end;) {
+        const uint32_t part_begin = i;
+
+        i = snapshot.subtree_end(i);
+        while (i < end && snapshot.subtree_end(i) - part_begin < PARALLEL_GRAIN) {
+            i = snapshot.subtree_end(i);
+        }
+
+        parts.emplace_back(part_begin, i);
+    }
+
+    parallel_for(parts.size(), [&](size_t k) {
+        const auto [part_begin, part_end] = parts[k];
+
+        if (part_end - part_begin < PARALLEL_GRAIN) {
+            calculate_range(rules, snapshot, base, part_begin, part_end, own_salaries, hired,
+                            entries);
+            return;
+        }
+
+        // Large subtree: all subordinates in parallel, then chief by them (in the same order as
+        // reverse scan does, so result is the same as sequential one)
+        calculate_range(rules, snapshot, base, part_begin + 1, part_end, own_salaries, hired,
+                        entries);
+
+        std::vector<uint32_t> subordinates;
+        for (uint32_t i = part_begin + 1; i < part_end; i = snapshot.subtree_end(i)) {
+            subordinates.push_back(i);
+        }
+
+        SalaryEntry& entry = entries[part_begin - base];
+        for (auto it = subordinates.rbegin(); it != subordinates.rend(); ++it) {
+            accumulate_entry(entry, entries[*it - base]);
+        }
+
+        complete_entry(rules, snapshot.type(part_begin), own_salaries[part_begin - base],
+                       hired[part_begin - base], entry);
+    });
+}
+
+//! Calculate salary entries of all employees of snapshot
+template<typename Rules>
+void SalaryCalculator::calculate_all_entries(const Rules&              rules,
+                                             const Snapshot&           snapshot,
+                                             month_t                   month,
+                                             std::vector<double>&      own_salaries,
+                                             std::vector<uint8_t>&     hired,
+                                             std::vector<SalaryEntry>& entries) const {
+    const uint32_t count = snapshot.size();
+
+    // 1.Seniority bonuses of all employees at once
+    calculate_own_salaries(rules, snapshot, 0, count, month, own_salaries.data(), hired.data());
+
+    // 2.All salary entries
+    std::fill(entries.begin(), entries.end(), SalaryEntry{});
+    calculate_range(rules, snapshot, 0, 0, count, own_salaries.data(), hired.data(),
+                    entries.data());
+}
+
+//! Sum salary entries of all employees of snapshot
+SalaryCalculator::PayrollSums
+SalaryCalculator::sum_entries(const Snapshot&                 snapshot,
+                              const std::vector<SalaryEntry>& entries) const {
+    const uint32_t count  = snapshot.size();
+    const size_t   chunks = (count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+
+    // 1.Sums of chunks (fixed, so sums do not depend on number of threads)
+    std::vector<PayrollSums> chunk_sums(chunks);
+
+    parallel_for(chunks, [&](size_t k) {
+        const uint32_t first = static_cast<uint32_t>(k * PARALLEL_GRAIN);
+        const uint32_t last  = std::min(count, first + PARALLEL_GRAIN);
+
+        PayrollSums& sums = chunk_sums[k];
+        for (uint32_t i = last; i > first; --i) {
+            const SalaryEntry& entry    = entries[i - 1];
+            CategoryPayroll&   category = sums.by_type[snapshot.type(i - 1)];
+
+            sums.total += entry.salary;
+            sums.ok = sums.ok && entry.ok;
+
+            category.total += entry.salary;
+            ++category.headcount;
+        }
+    });
+
+    // 2.Sums of all chunks
+    PayrollSums sums;
+    for (size_t k = chunks; k > 0; --k) {
+        const PayrollSums& chunk = chunk_sums[k - 1];
+
+        sums.total += chunk.total;
+        sums.ok = sums.ok && chunk.ok;
+
+        for (size_t t = 0; t < EMPLOYEE_TYPES_COUNT; ++t) {
+            sums.by_type.categories[t].total += chunk.by_type.categories[t].total;
+            sums.by_type.categories[t].headcount += chunk.by_type.categories[t].headcount;
+        }
     }
 
-    // 2.Bonus calcultaion
-    const std::vector<uuid_t> all_subordinates =
-        relation_manager_.get_all_subordinates(p_obj->get_id());
+    return sums;
+}
 
-    double subordinates_total_salary = 0.0;
-    for (const uuid_t& subordinate_id : all_subordinates) {
-        const auto [salary, ok] = calculate_month_salary(subordinate_id, date);
-        if (!ok) {
-            return {0.0, false};
+//! Calculate weights of salaries with seniority bonus only of snapshot range employees
+template<typename Rules>
+std::vector<double> SalaryCalculator::calculate_weights(const Rules&    rules,
+                                                        const Snapshot& snapshot,
+                                                        uint32_t        begin,
+                                                        uint32_t        end,
+                                                        double          own_weight) {
+    // Weight of employee salary in the sum: own weight, plus bonus rate of all subordinates of
+    // every chief above him times weight of chief salary, plus bonus rate of direct subordinates
+    // of his chief times weight of chief salary (part of all chiefs is accumulated down the tree)
+    std::vector<double> weights(end - begin);
+    std::vector<double> chiefs_weights(end - begin);
+
+    for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t chief = snapshot.chief(i);
+        if (chief == Snapshot::NONE || chief < begin) {
+            weights[i - begin] = 1.0;
+            continue;
         }
-        subordinates_total_salary += salary;
+
+        const double chief_weight = weights[chief - begin];
+
+        rules.visit(snapshot.type(chief), [&](const auto& chief_rules) {
+            double& chiefs_weight = chiefs_weights[i - begin];
+
+            chiefs_weight = chiefs_weights[chief - begin];
+            if (chief_rules.all_bonus_rate != 0.0) {
+                chiefs_weight += chief_rules.all_bonus_rate * chief_weight;
+            }
+
+            weights[i - begin] = own_weight + chiefs_weight;
+            if (chief_rules.direct_bonus_rate != 0.0) {
+                weights[i - begin] += chief_rules.direct_bonus_rate * chief_weight;
+            }
+        });
     }
 
-    subordinates_total_salary *= 0.03;
+    return weights;
+}
+
+//! Calculate the first months since which salaries of snapshot range employees are calculated
+template<typename Rules>
+std::vector<month_t> SalaryCalculator::calculate_required_months(const Rules&    rules,
+                                                                 const Snapshot& snapshot,
+                                                                 uint32_t        begin,
+                                                                 uint32_t        end) {
+    std::vector<month_t> required(end - begin);
+    std::vector<month_t> direct_required(end - begin, std::numeric_limits<month_t>::min());
+    std::vector<month_t> all_hired(end - begin, std::numeric_limits<month_t>::min());
+
+    // Reverse scan of pre-order (all subordinates are done before chief), the same rules as
+    // `complete_entry` has: bonus of direct subordinates needs all of them calculated, bonus of
+    // all subordinates needs all of them hired
+    for (uint32_t i = end; i > begin; --i) {
+        const uint32_t k = i - 1 - begin;
+
+        all_hired[k] = std::max(all_hired[k], snapshot.hire_month(i - 1));
+
+        rules.visit(snapshot.type(i - 1), [&](const auto& category) {
+            required[k] = snapshot.hire_month(i - 1);
+            if (category.direct_bonus_rate != 0.0) {
+                required[k] = std::max(required[k], direct_required[k]);
+            }
+            if (category.all_bonus_rate != 0.0) {
+                required[k] = std::max(required[k], all_hired[k]);
+            }
+        });
+
+        const uint32_t chief = snapshot.chief(i - 1);
+        if (chief != Snapshot::NONE && chief >= begin) {
+            direct_required[chief - begin] = std::max(direct_required[chief - begin], required[k]);
+            all_hired[chief - begin]       = std::max(all_hired[chief - begin], all_hired[k]);
+        }
+    }
 
-    return {base_salary + subordinates_total_salary, true};
-}
\ No newline at end of file
+    return required;
+}
+
+//! Calculate weighted sum of salaries with seniority bonus only for every month of range
+template<typename Rules>
+std::vector<double> SalaryCalculator::calculate_weighted_series(const Rules&               rules,
+                                                                const Snapshot&            snapshot,
+                                                                uint32_t                   begin,
+                                                                const std::vector<double>& weights,
+                                                                month_t                    first,
+                                                                month_t                    last) {
+    std::vector<double> series(last - first + 1, 0.0);
+
+    // 1.Changes of weighted sum: salary with seniority bonus only changes at hire month and at
+    // anniversary months until bonus is capped
+    for (size_t k = 0; k < weights.size(); ++k) {
+        if (weights[k] == 0.0) {
+            continue;
+        }
+
+        const uint32_t i           = begin + static_cast<uint32_t>(k);
+        const month_t  hire_month  = snapshot.hire_month(i);
+        const double   base_salary = snapshot.base_salary(i);
+        const auto [rate, cap]     = seniority_coefficients(rules, snapshot.type(i));
+
+        month_t month    = std::max(first, hire_month);
+        int     years    = (month - hire_month) / 12;
+        double  previous = 0.0;
+
+        while (month <= last) {
+            const double salary = seniority_salary(base_salary, rate, cap, years);
+
+            series[month - first] += weights[k] * (salary - previous);
+            previous = salary;
+
+            if (rate * years >= cap) {
+                break;
+            }
+            month = hire_month + 12 * ++years;
+        }
+    }
+
+    // 2.Weighted sum for every month
+    for (size_t m = 1; m < series.size(); ++m) {
+        series[m] += series[m - 1];
+    }
+
+    return series;
+}
+
+//! Run loop in parallel by thread pool
+void SalaryCalculator::parallel_for(size_t count, const std::function<void(size_t)>& body) const {
+    if (pool_ != nullptr && count > 1) {
+        pool_->run(count, body);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        body(i);
+    }
+}
+
+//! Complete salary entry of employee by already summed salaries of his subordinates
+template<typename Rules>
+void SalaryCalculator::complete_entry(const Rules& rules,
+                                      EmployeeType type,
+                                      double       own_salary,
+                                      bool         hired,
+                                      SalaryEntry& entry) {
+    // 1.Simple validation
+    if (!hired) {
+        entry.salary = 0.0;
+        entry.ok     = false;
+        return;
+    }
+
+    // 2.Bonus calculation (for subordinates): bonus with zero rate does not depend on them, so
+    // it is skipped (with built-in policy it is compiled out)
+    rules.visit(type, [&](const auto& category) {
+        entry.salary = own_salary;
+        entry.ok     = true;
+
+        if (category.direct_bonus_rate != 0.0) {
+            entry.salary += category.direct_bonus_rate * entry.direct_total;
+            entry.ok = entry.ok && entry.direct_ok;
+        }
+        if (category.all_bonus_rate != 0.0) {
+            entry.salary += category.all_bonus_rate * entry.all_total;
+            entry.ok = entry.ok && entry.all_ok;
+        }
+    });
+
+    if (!entry.ok) {
+        entry.salary = 0.0;
+    }
+}
+
+//! Get seniority bonus coefficients of employee category
+template<typename Rules>
+std::pair<double, double> SalaryCalculator::seniority_coefficients(const Rules& rules,
+                                                                   EmployeeType type) {
+    return rules.visit(type, [](const auto& category) {
+        return std::pair<double, double>{category.seniority_rate, category.seniority_cap};
+    });
+}
+
+//! Add salary entry of subordinate to sums of his chief
+void SalaryCalculator::accumulate_entry(SalaryEntry& chief, const SalaryEntry& subordinate) {
+    chief.direct_ok = chief.direct_ok && subordinate.ok;
+    chief.all_ok    = chief.all_ok && subordinate.ok && subordinate.all_ok;
+
+    chief.direct_total += subordinate.salary;
+    chief.all_total += subordinate.salary + subordinate.all_total;
+}
@@ -1,78 +1,500 @@
 #pragma once
 
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+#include <employee_lib/Month.h>
+#include <employee_lib/PayrollByType.h>
+#include <employee_lib/SalaryPolicy.h>
+
+// relative includes
+#include "RegistryVersion.h"
+
 // boost includes
-#include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/uuid/uuid.hpp>
 
+// C++ includes
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
 namespace employee
 {
 
-class Employee;
-class RelationManager;
+class Snapshot;
+class ThreadPool;
 
 /**
  * @class SalaryCalculator
  * @brief Class for work with salary algorithms calculation
+ *
+ * All calculations are performed over immutable snapshot of employees and hierarchy, so they
+ * are consistent even if source data are changed concurrently. Salary of specific employee is
+ * calculated over published registry version too, so it does not need snapshot of the whole
+ * registry after every change.
+ *
+ * Memoized salaries are only read during calculation (concurrent calculations do not block each
+ * other), new entries are memoized at once by the end of it.
+ *
+ * If thread pool is given, large subtrees are split into parts of whole subtrees calculated in
+ * parallel; parts are combined in fixed order, so results do not depend on number of threads and
+ * on scheduling.
+ *
+ * Salary rules are given by salary policy: built-in one is compiled with rules of every category
+ * as constants, runtime one is a flat coefficients table. Both are template parameters of all
+ * calculation kernels, so rules of employee are taken without virtual calls.
  */
 class SalaryCalculator {
 public:
-    SalaryCalculator() = delete;
-
     SalaryCalculator(const SalaryCalculator& other)  = delete;
     SalaryCalculator(const SalaryCalculator&& other) = delete;
 
     SalaryCalculator& operator=(const SalaryCalculator& other)  = delete;
     SalaryCalculator& operator=(const SalaryCalculator&& other) = delete;
 
+    SalaryCalculator() = delete;
+
     /**
      * Contruct salary calculator entity
-     * @param storage storage of Employee objects (const reference)
-     * @param relation_mgr relation manager (const reference)
+     * @param pool thread pool for parallel calculations (nullptr for sequential ones)
+     * @param policy salary policy (nullopt for built-in one)
      */
-    SalaryCalculator(const boost::unordered_map<boost::uuids::uuid, Employee*>& storage,
-                     const RelationManager&                                     relation_mgr);
+    SalaryCalculator(ThreadPool* pool, const std::optional<SalaryPolicy>& policy);
 
     /**
      * @brief Calculate month salary of specific employee
+     * @param snapshot snapshot of employees and hierarchy
      * @param id employee identifier
-     * @param date estimated date of salary payment
+     * @param month month of salary payment
      * @return calculated salary and success flag
      */
-    std::pair<double, bool> calculate_month_salary(const boost::uuids::uuid&     id,
-                                                   const boost::gregorian::date& date) const;
+    std::pair<double, bool> calculate_month_salary(const Snapshot&           snapshot,
+                                                   const boost::uuids::uuid& id,
+                                                   month_t                   month) const;
 
-private:
     /**
-     * @brief Calculate month salary of worker
-     * @param p_obj Worker entity
-     * @param date estimated date of salary payment
+     * @brief Calculate month salary of specific employee over registry version (only his subtree
+     * employees without valid memoized entries are visited)
+     * @param registry registry version
+     * @param id employee identifier
+     * @param month month of salary payment
      * @return calculated salary and success flag
      */
-    std::pair<double, bool> calculate_worker_salary(const Employee*               p_obj,
-                                                    const boost::gregorian::date& date) const;
+    std::pair<double, bool> calculate_month_salary(const RegistryVersion&    registry,
+                                                   const boost::uuids::uuid& id,
+                                                   month_t                   month) const;
 
     /**
-     * @brief Calculate month salary of foreman
-     * @param p_obj Foreman entity
-     * @param date estimated date of salary payment
-     * @return calculated salary and success flag
+     * @brief Calculate total month salary of all employees in a single bottom-up pass
+     * Every employee is calculated right after all his subordinates, so their salaries are
+     * reused by chiefs instead of being recalculated
+     * @param snapshot snapshot of employees and hierarchy
+     * @param month month of salary payment
+     * @return calculated total salary and success flag
      */
-    std::pair<double, bool> calculate_foreman_salary(const Employee*               p_obj,
-                                                     const boost::gregorian::date& date) const;
+    std::pair<double, bool> calculate_total_salary(const Snapshot& snapshot, month_t month) const;
 
     /**
-     * @brief Calculate month salary of manager
-     * @param p_obj Manager entity
-     * @param date estimated date of salary payment
-     * @return calculated salary and success flag
+     * @brief Calculate total month salary of all employees for a batch of months
+     * Seniority bonuses of all employees are calculated by vectorized batch kernel
+     * @param snapshot snapshot of employees and hierarchy
+     * @param months months of salary payment
+     * @return calculated total salary and success flag for every month
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_total_salaries(const Snapshot& snapshot, const std::vector<month_t>& months) const;
+
+    /**
+     * @brief Calculate total month salary and headcount of every employee category in a single
+     * bottom-up pass (subtree salary sums are shared by bonuses of foremen and managers)
+     * @param snapshot snapshot of employees and hierarchy
+     * @param month month of salary payment
+     * @return payroll of every category and success flag
+     */
+    std::pair<PayrollByType, bool> calculate_payroll_by_type(const Snapshot& snapshot,
+                                                             month_t         month) const;
+
+    /**
+     * @brief Calculate month salaries of specific employee for a range of months in a single
+     * subtree traversal
+     * Salary of employee is a weighted sum of salaries with seniority bonus only of his subtree
+     * employees, and those change only at hire and anniversary months, so the whole series costs
+     * one traversal plus a few changes per employee
+     * @param snapshot snapshot of employees and hierarchy
+     * @param id employee identifier
+     * @param first the first month of series
+     * @param last the last month of series (inclusive)
+     * @return calculated salary and success flag for every month
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_salary_series(const Snapshot&           snapshot,
+                            const boost::uuids::uuid& id,
+                            month_t                   first,
+                            month_t                   last) const;
+
+    /**
+     * @brief Calculate total month salary of all employees for a range of months in a single
+     * traversal (see `calculate_salary_series`)
+     * @param snapshot snapshot of employees and hierarchy
+     * @param first the first month of series
+     * @param last the last month of series (inclusive)
+     * @return calculated total salary and success flag for every month
+     */
+    std::vector<std::pair<double, bool>>
+    calculate_total_salary_series(const Snapshot& snapshot, month_t first, month_t last) const;
+
+    /**
+     * @brief Drop memoized salaries of employees (for all months)
+     * Attention! Must be called for the whole chiefs chain of an employee whose subordinates
+     * were changed, because subtree salary sums of all of them are affected
+     * @param ids employees unique identifiers
+     * @param version version of source data where employees were changed
+     */
+    void invalidate(const std::vector<boost::uuids::uuid>& ids, uint64_t version);
+
+    /**
+     * @brief Forget removed employee: drop his memoized salaries and his change version
+     * Attention! His chiefs must be invalidated separately (see `invalidate`)
+     * @param id employee unique identifier
+     * @param version version of source data where employee was removed
      */
-    std::pair<double, bool> calculate_manager_salary(const Employee*               p_obj,
-                                                     const boost::gregorian::date& date) const;
+    void forget(const boost::uuids::uuid& id, uint64_t version);
 
 private:
-    const boost::unordered_map<boost::uuids::uuid, Employee*>& employees_;
-    const RelationManager&                                     relation_manager_;
+    /**
+     * @struct SalaryEntry
+     * @brief Month salary of employee together with his subtree salary sums
+     */
+    struct SalaryEntry {
+        double salary       = 0.0;   //!< Month salary of employee
+        double direct_total = 0.0;   //!< Total salary of direct subordinates
+        double all_total    = 0.0;   //!< Total salary of all subordinates
+        bool   ok           = false; //!< Salary of employee was calculated
+        bool   direct_ok    = true;  //!< Salaries of direct subordinates were calculated
+        bool   all_ok       = true;  //!< Salaries of all subordinates were calculated
+    };
+
+    /**
+     * @struct MemoEntry
+     * @brief Memoized salary entry with version of snapshot it was calculated by
+     */
+    struct MemoEntry {
+        SalaryEntry entry;   //!< Salary entry
+        uint64_t    version; //!< Version of snapshot
+        month_t     month;   //!< Month ordinal
+    };
+
+    /**
+     * @struct MemoMonths
+     * @brief Memoized salary entries of employee for the last memoized months (ring buffer: entry
+     * of the oldest memoized month is replaced when buffer is full)
+     */
+    struct MemoMonths {
+        std::vector<MemoEntry> entries;  //!< Entries (at most `MEMO_MONTHS`)
+        size_t                 next = 0; //!< Entry replaced by the next new month
+    };
+
+    //!< Salary entries calculated for memoization: "employee-->salary entry"
+    using CalculatedEntries = std::vector<std::pair<boost::uuids::uuid, SalaryEntry>>;
+
+    /**
+     * @struct PayrollSums
+     * @brief Sums of salary entries of all employees
+     */
+    struct PayrollSums {
+        double        total = 0.0;  //!< Total salary of all employees
+        PayrollByType by_type;      //!< Total salary and headcount of every category
+        bool          ok    = true; //!< Salaries of all employees were calculated
+    };
+
+    /**
+     * @brief Find memoized salary entry valid for snapshot version
+     * Attention! Lock of `mtx_` must be held by the caller
+     * @param id employee identifier
+     * @param month month ordinal
+     * @param version version of snapshot
+     * @return salary entry (nullptr if there is no valid one)
+     */
+    const SalaryEntry* find_memoized(const boost::uuids::uuid& id,
+                                     month_t                   month,
+                                     uint64_t                  version) const;
+
+    /**
+     * @brief Memoize salary entry (unless there is entry of newer snapshot)
+     * Attention! Unique lock of `mtx_` must be held by the caller
+     * @param id employee identifier
+     * @param month month ordinal
+     * @param version version of snapshot
+     * @param entry salary entry
+     */
+    void memoize(const boost::uuids::uuid& id,
+                 month_t                   month,
+                 uint64_t                  version,
+                 const SalaryEntry&        entry) const;
+
+    /**
+     * @brief Memoize calculated salary entries (see `memoize`) under unique lock of `mtx_`
+     * @param entries calculated salary entries
+     * @param month month ordinal
+     * @param version version of source data
+     */
+    void memoize_all(const CalculatedEntries& entries, month_t month, uint64_t version) const;
+
+    /**
+     * @brief Call body with salary rules of policy (`BuiltinSalaryRules` or `TableSalaryRules`)
+     * @param body generic callable taking rules
+     * @return result of body
+     */
+    template<typename Body>
+    decltype(auto) with_rules(Body&& body) const;
+
+    /**
+     * @brief Calculate salary entry of employee (missing entries of his subtree are calculated
+     * in post-order)
+     * Attention! Shared lock of `mtx_` must be held by the caller
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param index employee index in snapshot
+     * @param month month ordinal
+     * @param calculated calculated entries to memoize (appended)
+     * @return salary entry
+     */
+    template<typename Rules>
+    SalaryEntry calculate_entry(const Rules&       rules,
+                                const Snapshot&    snapshot,
+                                uint32_t           index,
+                                month_t            month,
+                                CalculatedEntries& calculated) const;
+
+    /**
+     * @brief Calculate salary entry of employee over registry version and memoize it together
+     * with missing entries of his subtree (large subtree is split into subtrees of direct
+     * subordinates calculated in parallel)
+     * @param rules salary rules
+     * @param registry registry version
+     * @param id employee identifier
+     * @param record employee record
+     * @param month month ordinal
+     * @return salary entry
+     */
+    template<typename Rules>
+    SalaryEntry calculate_registry_entry(const Rules&                   rules,
+                                         const RegistryVersion&         registry,
+                                         const boost::uuids::uuid&      id,
+                                         const RegistryVersion::Record& record,
+                                         month_t                        month) const;
+
+    /**
+     * @brief Calculate salary entry of employee by whole subtree calculation (in parallel,
+     * without memoized entries)
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param index employee index in snapshot
+     * @param month month ordinal
+     * @return salary entry
+     */
+    template<typename Rules>
+    SalaryEntry calculate_subtree_entry(const Rules&    rules,
+                                        const Snapshot& snapshot,
+                                        uint32_t        index,
+                                        month_t         month) const;
+
+    /**
+     * @brief Calculate salaries with seniority bonus only for snapshot range
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param begin begin of range
+     * @param end end of range
+     * @param month month ordinal
+     * @param own_salaries calculated salaries (by index from `begin`)
+     * @param hired hired flags (by index from `begin`)
+     */
+    template<typename Rules>
+    void calculate_own_salaries(const Rules&    rules,
+                                const Snapshot& snapshot,
+                                uint32_t        begin,
+                                uint32_t        end,
+                                month_t         month,
+                                double*         own_salaries,
+                                uint8_t*        hired) const;
+
+    /**
+     * @brief Calculate salary entries of all employees of snapshot range
+     * Attention! Range must consist of whole subtrees
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param base index of the first element of arrays
+     * @param begin begin of range
+     * @param end end of range
+     * @param own_salaries salaries with seniority bonus only (by index from `base`)
+     * @param hired hired flags (by index from `base`)
+     * @param entries calculated salary entries (by index from `base`)
+     */
+    template<typename Rules>
+    void calculate_range(const Rules&    rules,
+                         const Snapshot& snapshot,
+                         uint32_t        base,
+                         uint32_t        begin,
+                         uint32_t        end,
+                         const double*   own_salaries,
+                         const uint8_t*  hired,
+                         SalaryEntry*    entries) const;
+
+    /**
+     * @brief Calculate salary entries of all employees of snapshot
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param month month ordinal
+     * @param own_salaries buffer for salaries with seniority bonus only (by index)
+     * @param hired buffer for hired flags (by index)
+     * @param entries calculated salary entries (by index)
+     */
+    template<typename Rules>
+    void calculate_all_entries(const Rules&              rules,
+                               const Snapshot&           snapshot,
+                               month_t                   month,
+                               std::vector<double>&      own_salaries,
+                               std::vector<uint8_t>&     hired,
+                               std::vector<SalaryEntry>& entries) const;
+
+    /**
+     * @brief Sum salary entries of all employees of snapshot (in fixed chunks, so sums do not
+     * depend on number of threads)
+     * @param snapshot snapshot of employees and hierarchy
+     * @param entries salary entries (by index)
+     * @return sums of salary entries
+     */
+    PayrollSums sum_entries(const Snapshot&                 snapshot,
+                            const std::vector<SalaryEntry>& entries) const;
+
+    /**
+     * @brief Calculate weights of salaries with seniority bonus only of snapshot range employees
+     * in sum of salaries (in pre-order: weight of employee depends on weights of his chiefs)
+     * Attention! Range must consist of whole subtrees
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param begin begin of range
+     * @param end end of range
+     * @param own_weight weight of salary of every subordinate itself (0.0 for salary of range
+     * root, 1.0 for total salary of all range employees)
+     * @return weights (by index from `begin`)
+     */
+    template<typename Rules>
+    static std::vector<double> calculate_weights(const Rules&    rules,
+                                                 const Snapshot& snapshot,
+                                                 uint32_t        begin,
+                                                 uint32_t        end,
+                                                 double          own_weight);
+
+    /**
+     * @brief Calculate the first months since which salaries of snapshot range employees are
+     * calculated (employee and subordinates his bonus depends on are hired)
+     * Attention! Range must consist of whole subtrees
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param begin begin of range
+     * @param end end of range
+     * @return required months (by index from `begin`)
+     */
+    template<typename Rules>
+    static std::vector<month_t> calculate_required_months(const Rules&    rules,
+                                                          const Snapshot& snapshot,
+                                                          uint32_t        begin,
+                                                          uint32_t        end);
+
+    /**
+     * @brief Calculate weighted sum of salaries with seniority bonus only of snapshot range
+     * employees for every month of range (by their changes at hire and anniversary months)
+     * @param rules salary rules
+     * @param snapshot snapshot of employees and hierarchy
+     * @param begin begin of range
+     * @param weights weights of employees (by index from `begin`)
+     * @param first the first month
+     * @param last the last month (inclusive)
+     * @return weighted sum for every month
+     */
+    template<typename Rules>
+    static std::vector<double> calculate_weighted_series(const Rules&               rules,
+                                                         const Snapshot&            snapshot,
+                                                         uint32_t                   begin,
+                                                         const std::vector<double>& weights,
+                                                         month_t                    first,
+                                                         month_t                    last);
+
+    /**
+     * @brief Run loop in parallel by thread pool (or sequentially if there is no pool)
+     * @param count number of iterations
+     * @param body body of loop
+     */
+    void parallel_for(size_t count, const std::function<void(size_t)>& body) const;
+
+    /**
+     * @brief Complete salary entry of employee by already summed salaries of his subordinates
+     * @param rules salary rules
+     * @param type employee category
+     * @param own_salary employee salary with seniority bonus only
+     * @param hired employee was hired at the month of salary payment
+     * @param entry salary entry with subordinates sums
+     */
+    template<typename Rules>
+    static void complete_entry(const Rules& rules,
+                               EmployeeType type,
+                               double       own_salary,
+                               bool         hired,
+                               SalaryEntry& entry);
+
+    /**
+     * @brief Get seniority bonus coefficients of employee category
+     * @param rules salary rules
+     * @param type employee category
+     * @return bonus rate for every full year of service and bonus cap
+     */
+    template<typename Rules>
+    static std::pair<double, double> seniority_coefficients(const Rules& rules, EmployeeType type);
+
+    /**
+     * @brief Add salary entry of subordinate to sums of his chief
+     * @param chief salary entry of chief
+     * @param subordinate salary entry of subordinate
+     */
+    static void accumulate_entry(SalaryEntry& chief, const SalaryEntry& subordinate);
+
+private:
+    //!< Minimal size of range calculated in parallel
+    static constexpr uint32_t PARALLEL_GRAIN = 4096;
+
+    //!< Size of range for which salaries with seniority bonus are calculated at once
+    static constexpr uint32_t OWN_SALARIES_CHUNK = 1024;
+
+    //!< Number of months memoized for every employee
+    static constexpr size_t MEMO_MONTHS = 12;
+
+    //!< Number of employees visited by calculation between releases of `mtx_` (so invalidations
+    //!< by writers do not wait for the whole subtree)
+    static constexpr uint32_t MEMO_LOCK_GRAIN = 1024;
+
+    //!< Thread pool for parallel calculations (nullptr for sequential ones)
+    ThreadPool* pool_;
+
+    //!< Runtime salary policy (nullopt for built-in one)
+    std::optional<SalaryPolicy> policy_;
+
+    //!< Mutex for memoized salaries sync: calculations run concurrently, so memoized salaries
+    //!< need their own lock
+    mutable std::shared_mutex mtx_;
+
+    //!< Memoized salaries "employee-->salary entries of the last months"
+    mutable boost::unordered_map<boost::uuids::uuid, MemoMonths> salaries_;
+
+    //!< Latest source data version where employee subtree was changed
+    boost::unordered_map<boost::uuids::uuid, uint64_t> changed_versions_;
+
+    //!< Latest source data version where employee was forgotten: change versions of forgotten
+    //!< employees are dropped, so entries of older snapshots are not memoized for employees
+    //!< without change version
+    uint64_t forgotten_version_ = 0;
 };
 
-} // namespace employee
\ No newline at end of file
+} // namespace employee
@@ -0,0 +1,76 @@
+// lib includes
+#include <employee_lib/SalaryPolicy.h>
+
+// C++ includes
+#include <cmath>
+#include <sstream>
+
+using namespace employee;
+
+namespace
+{
+
+//! Parse name of employee category
+std::optional<EmployeeType> parse_type(const std::string& name) {
+    if (name == "worker") {
+        return EmployeeType::WORKER;
+    }
+    if (name == "foreman") {
+        return EmployeeType::FOREMAN;
+    }
+    if (name == "manager") {
+        return EmployeeType::MANAGER;
+    }
+
+    return std::nullopt;
+}
+
+//! Check salary coefficient
+bool is_valid_coefficient(double value) {
+    return std::isfinite(value) && value >= 0.0;
+}
+
+} // namespace
+
+//! Parse salary policy from text
+std::optional<SalaryPolicy> employee::parse_salary_policy(const std::string& text) {
+    SalaryPolicy policy = DEFAULT_SALARY_POLICY;
+
+    std::istringstream input(text);
+    std::string        line;
+
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+
+        // 1.Empty lines and comments are skipped
+        std::string name;
+        if (!(fields >> name) || name.front() == '#') {
+            continue;
+        }
+
+        // 2.Category and all its coefficients (nothing else is allowed in line)
+        const std::optional<EmployeeType> type = parse_type(name);
+
+        CategoryRules rules;
+        if (!type || !(fields >> rules.seniority_rate >> rules.seniority_cap >>
+                       rules.direct_bonus_rate >> rules.all_bonus_rate)) {
+            return std::nullopt;
+        }
+
+        std::string rest;
+        if (fields >> rest) {
+            return std::nullopt;
+        }
+
+        if (!is_valid_coefficient(rules.seniority_rate) ||
+            !is_valid_coefficient(rules.seniority_cap) ||
+            !is_valid_coefficient(rules.direct_bonus_rate) ||
+            !is_valid_coefficient(rules.all_bonus_rate)) {
+            return std::nullopt;
+        }
+
+        policy[*type] = rules;
+    }
+
+    return policy;
+}
@@ -0,0 +1,171 @@
+// relative includes
+#include "SalaryRequests.h"
+
+// C++ includes
+#include <atomic>
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+//! Construct requests and start executor
+SalaryRequests::SalaryRequests(size_t threads, Calculation calculation) :
+    calculation_(std::move(calculation)), executor_(threads) {}
+
+//! Complete all pending requests and destruct object
+SalaryRequests::~SalaryRequests() = default;
+
+//! Request salary of employee
+std::shared_future<SalaryRequests::Result>
+SalaryRequests::request(const uuid_t& id, month_t month, uint64_t version) {
+    return acquire({id}, month, version, {}).front()->future;
+}
+
+//! Request salary of employee with completion callback
+void SalaryRequests::request(const uuid_t& id,
+                             month_t       month,
+                             uint64_t      version,
+                             Callback      callback) {
+    std::vector<Completion> callbacks;
+    callbacks.push_back(
+        [callback = std::move(callback)](const std::exception_ptr& error, const Result& result) {
+            callback(error ? Result{0.0, false} : result);
+        });
+
+    acquire({id}, month, version, std::move(callbacks));
+}
+
+//! Request salaries of batch of employees
+std::future<std::vector<SalaryRequests::Result>>
+SalaryRequests::request(const std::vector<uuid_t>& ids, month_t month, uint64_t version) {
+    // Results of batch collected by completion callbacks of its requests
+    struct Batch {
+        std::promise<std::vector<Result>> promise;
+        std::vector<Result>               results;
+        std::atomic<size_t>               remaining;
+        std::mutex                        mtx;
+        std::exception_ptr                error;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    batch->results.resize(ids.size());
+    batch->remaining = ids.size();
+
+    std::future<std::vector<Result>> future = batch->promise.get_future();
+    if (ids.empty()) {
+        batch->promise.set_value({});
+        return future;
+    }
+
+    std::vector<Completion> callbacks;
+    callbacks.reserve(ids.size());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        callbacks.push_back([batch, i](const std::exception_ptr& error, const Result& result) {
+            if (error) {
+                std::lock_guard<std::mutex> lock(batch->mtx);
+                batch->error = error;
+            } else {
+                batch->results[i] = result;
+            }
+
+            // The last completed request delivers the whole batch (or exception of any request)
+            if (--batch->remaining == 0) {
+                if (batch->error) {
+                    batch->promise.set_exception(batch->error);
+                } else {
+                    batch->promise.set_value(std::move(batch->results));
+                }
+            }
+        });
+    }
+
+    acquire(ids, month, version, std::move(callbacks));
+
+    return future;
+}
+
+//! Find or create pending requests of batch and queue calculation of created ones
+std::vector<std::shared_ptr<SalaryRequests::Pending>>
+SalaryRequests::acquire(const std::vector<uuid_t>& ids,
+                        month_t                    month,
+                        uint64_t                   version,
+                        std::vector<Completion>&&  callbacks) {
+    std::vector<std::shared_ptr<Pending>> result;
+    result.reserve(ids.size());
+
+    std::vector<Key>                      created_keys;
+    std::vector<std::shared_ptr<Pending>> created;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            const Key key{ids[i], month, version};
+
+            // Pay attention: completed requests are removed from map under the same lock, so
+            // callback added to found request is always called
+            std::shared_ptr<Pending>& pending = pending_[key];
+            if (pending == nullptr) {
+                pending         = std::make_shared<Pending>();
+                pending->future = pending->promise.get_future().share();
+
+                created_keys.push_back(key);
+                created.push_back(pending);
+            }
+
+            if (!callbacks.empty()) {
+                pending->callbacks.push_back(std::move(callbacks[i]));
+            }
+            result.push_back(pending);
+        }
+    }
+
+    if (!created.empty()) {
+        executor_.submit([this, keys = std::move(created_keys), pendings = std::move(created)] {
+            calculate(keys, pendings);
+        });
+    }
+
+    return result;
+}
+
+//! Calculate created pending requests and complete them
+void SalaryRequests::calculate(const std::vector<Key>&                      keys,
+                               const std::vector<std::shared_ptr<Pending>>& pendings) {
+    std::vector<uuid_t> ids;
+    ids.reserve(keys.size());
+
+    for (const Key& key : keys) {
+        ids.push_back(key.id);
+    }
+
+    // Pay attention: requests are completed even if calculation throws, otherwise their waiters
+    // would hang and pending requests would be never removed
+    std::vector<Result> results;
+    std::exception_ptr  error;
+    try {
+        results = calculation_(ids, keys.front().month);
+    } catch (...) {
+        error = std::current_exception();
+        results.resize(keys.size(), Result{0.0, false});
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::vector<Completion> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            pending_.erase(keys[i]);
+            callbacks.swap(pendings[i]->callbacks);
+        }
+
+        if (error) {
+            pendings[i]->promise.set_exception(error);
+        } else {
+            pendings[i]->promise.set_value(results[i]);
+        }
+        for (const Completion& callback : callbacks) {
+            callback(error, results[i]);
+        }
+    }
+}
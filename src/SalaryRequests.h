@@ -0,0 +1,170 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/Month.h>
+
+// boost includes
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/uuid/uuid.hpp>
+
+// relative includes
+#include "Executor.h"
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class SalaryRequests
+ * @brief Class of asynchronous salary requests calculated by internal executor
+ *
+ * Requests are coalesced: while salary of employee for month is being calculated, repeated
+ * requests of the same data version join the pending one instead of queuing a new calculation.
+ * Requests of a batch are calculated by a single task, so the whole batch is calculated over the
+ * same snapshot and subtrees shared by its employees are calculated once.
+ */
+class SalaryRequests {
+public:
+    //!< Month salary and success flag
+    using Result = std::pair<double, bool>;
+
+    //!< Completion callback (called by thread of executor)
+    using Callback = std::function<void(const Result&)>;
+
+    //!< Completion of request (exception of calculation or nullptr, then result)
+    using Completion = std::function<void(const std::exception_ptr&, const Result&)>;
+
+    //!< Calculation of batch of salaries for month (results in order of identifiers)
+    using Calculation =
+        std::function<std::vector<Result>(const std::vector<boost::uuids::uuid>&, month_t)>;
+
+    SalaryRequests() = delete;
+
+    SalaryRequests(const SalaryRequests& other)  = delete;
+    SalaryRequests(const SalaryRequests&& other) = delete;
+
+    SalaryRequests& operator=(const SalaryRequests& other)  = delete;
+    SalaryRequests& operator=(const SalaryRequests&& other) = delete;
+
+    /**
+     * @brief Construct requests and start executor
+     * @param threads number of threads of executor
+     * @param calculation calculation of batch of salaries
+     */
+    SalaryRequests(size_t threads, Calculation calculation);
+
+    /**
+     * @brief Complete all pending requests and destruct object
+     */
+    ~SalaryRequests();
+
+    /**
+     * @brief Request salary of employee
+     * @param id employee unique identifier
+     * @param month month ordinal
+     * @param version data version at moment of request (result is calculated over this or newer
+     * one)
+     * @return future of result (it holds the exception if calculation throws)
+     */
+    std::shared_future<Result>
+    request(const boost::uuids::uuid& id, month_t month, uint64_t version);
+
+    /**
+     * @brief Request salary of employee with completion callback
+     * @param id employee unique identifier
+     * @param month month ordinal
+     * @param version data version at moment of request
+     * @param callback completion callback (called with failed result if calculation throws)
+     */
+    void request(const boost::uuids::uuid& id, month_t month, uint64_t version, Callback callback);
+
+    /**
+     * @brief Request salaries of batch of employees
+     * @param ids employees unique identifiers
+     * @param month month ordinal
+     * @param version data version at moment of request
+     * @return future of results (in order of identifiers; it holds the exception if calculation
+     * throws)
+     */
+    std::future<std::vector<Result>>
+    request(const std::vector<boost::uuids::uuid>& ids, month_t month, uint64_t version);
+
+private:
+    /**
+     * @struct Key
+     * @brief Key of pending request
+     */
+    struct Key {
+        boost::uuids::uuid id;      //!< Employee unique identifier
+        month_t            month;   //!< Month ordinal
+        uint64_t           version; //!< Data version
+
+        bool operator==(const Key& other) const {
+            return id == other.id && month == other.month && version == other.version;
+        }
+
+        friend size_t hash_value(const Key& key) {
+            size_t seed = boost::hash<boost::uuids::uuid>{}(key.id);
+            boost::hash_combine(seed, key.month);
+            boost::hash_combine(seed, key.version);
+
+            return seed;
+        }
+    };
+
+    /**
+     * @struct Pending
+     * @brief Pending request (shared by all coalesced requests)
+     */
+    struct Pending {
+        std::promise<Result>       promise;   //!< Result of calculation
+        std::shared_future<Result> future;    //!< Future of result
+        std::vector<Completion>    callbacks; //!< Completions of coalesced requests
+    };
+
+    /**
+     * @brief Find or create pending requests of batch and queue calculation of created ones
+     * @param ids employees unique identifiers
+     * @param month month ordinal
+     * @param version data version at moment of request
+     * @param callbacks completions of requests (empty or one per identifier)
+     * @return pending requests (in order of identifiers)
+     */
+    std::vector<std::shared_ptr<Pending>>
+    acquire(const std::vector<boost::uuids::uuid>& ids,
+            month_t                                month,
+            uint64_t                               version,
+            std::vector<Completion>&&              callbacks);
+
+    /**
+     * @brief Calculate created pending requests and complete them (exception of calculation is
+     * passed to all of them)
+     * @param keys keys of requests
+     * @param pendings pending requests (in order of keys)
+     */
+    void calculate(const std::vector<Key>&                      keys,
+                   const std::vector<std::shared_ptr<Pending>>& pendings);
+
+private:
+    Calculation calculation_; //!< Calculation of batch of salaries
+
+    std::mutex                                          mtx_;     //!< Guards pending requests
+    boost::unordered_map<Key, std::shared_ptr<Pending>> pending_; //!< Pending requests
+
+    // Pay attention: executor is the last member, so it completes queued calculations before
+    // other members are destructed
+    Executor executor_; //!< Executor of calculations
+};
+
+} // namespace employee
@@ -0,0 +1,81 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/SalaryPolicy.h>
+
+namespace employee
+{
+
+/**
+ * @struct BuiltinCategoryRules
+ * @brief Rules of employee category of built-in policy as compile-time constants
+ */
+template<EmployeeType TYPE>
+struct BuiltinCategoryRules {
+    static constexpr double seniority_rate    = DEFAULT_SALARY_POLICY[TYPE].seniority_rate;
+    static constexpr double seniority_cap     = DEFAULT_SALARY_POLICY[TYPE].seniority_cap;
+    static constexpr double direct_bonus_rate = DEFAULT_SALARY_POLICY[TYPE].direct_bonus_rate;
+    static constexpr double all_bonus_rate    = DEFAULT_SALARY_POLICY[TYPE].all_bonus_rate;
+};
+
+/**
+ * @class BuiltinSalaryRules
+ * @brief Class of salary rules of built-in policy
+ *
+ * Visitor is instantiated for rules of every category separately, so coefficients are constants
+ * of its code and bonuses with zero rate are compiled out.
+ */
+class BuiltinSalaryRules {
+public:
+    /**
+     * @brief Call visitor with rules of employee category
+     * @param type employee category
+     * @param visitor generic callable taking rules (`CategoryRules`-like object)
+     * @return result of visitor
+     */
+    template<typename Visitor>
+    decltype(auto) visit(EmployeeType type, Visitor&& visitor) const {
+        switch (type) {
+            case EmployeeType::WORKER:
+                return visitor(BuiltinCategoryRules<EmployeeType::WORKER>{});
+
+            case EmployeeType::FOREMAN:
+                return visitor(BuiltinCategoryRules<EmployeeType::FOREMAN>{});
+
+            default:
+                break;
+        }
+
+        return visitor(BuiltinCategoryRules<EmployeeType::MANAGER>{});
+    }
+};
+
+/**
+ * @class TableSalaryRules
+ * @brief Class of salary rules of runtime policy (coefficients are loaded from flat table by
+ * category, without branches)
+ */
+class TableSalaryRules {
+public:
+    /**
+     * @brief Construct rules over policy
+     * @param policy salary policy (must outlive rules)
+     */
+    explicit TableSalaryRules(const SalaryPolicy& policy) : policy_(policy) {}
+
+    /**
+     * @brief Call visitor with rules of employee category
+     * @param type employee category
+     * @param visitor generic callable taking rules (`CategoryRules`-like object)
+     * @return result of visitor
+     */
+    template<typename Visitor>
+    decltype(auto) visit(EmployeeType type, Visitor&& visitor) const {
+        return visitor(policy_[type]);
+    }
+
+private:
+    const SalaryPolicy& policy_; //!< Salary policy
+};
+
+} // namespace employee
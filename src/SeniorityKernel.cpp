@@ -0,0 +1,110 @@
+// relative includes
+#include "SeniorityKernel.h"
+
+// C++ includes
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EMPLOYEE_LIB_HAS_AVX2_KERNEL 1
+#endif
+
+using namespace employee;
+
+namespace
+{
+
+//! Scalar kernel (fallback and tail of vectorized one)
+void calculate_seniority_salaries_scalar(size_t         count,
+                                         const month_t* hire_months,
+                                         const double*  base_salaries,
+                                         const double*  rates,
+                                         const double*  caps,
+                                         month_t        month,
+                                         double*        salaries,
+                                         uint8_t*       hired) {
+    for (size_t i = 0; i < count; ++i) {
+        const int months_diff = month - hire_months[i];
+
+        hired[i]    = months_diff >= 0;
+        salaries[i] = hired[i] ? seniority_salary(base_salaries[i], rates[i], caps[i],
+                                                  months_diff / 12)
+                               : 0.0;
+    }
+}
+
+#ifdef EMPLOYEE_LIB_HAS_AVX2_KERNEL
+
+//! AVX2 kernel: 4 employees per iteration
+__attribute__((target("avx2"))) void
+calculate_seniority_salaries_avx2(size_t         count,
+                                  const month_t* hire_months,
+                                  const double*  base_salaries,
+                                  const double*  rates,
+                                  const double*  caps,
+                                  month_t        month,
+                                  double*        salaries,
+                                  uint8_t*       hired) {
+    const __m128i month_vec  = _mm_set1_epi32(month);
+    const __m256d twelve_vec = _mm256_set1_pd(12.0);
+    const __m256d zero_vec   = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // 1.Months of service and hired mask
+        const __m128i hire_vec =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(hire_months + i));
+        const __m128i diff_vec  = _mm_sub_epi32(month_vec, hire_vec);
+        const __m128i fired_vec = _mm_cmplt_epi32(diff_vec, _mm_setzero_si128());
+
+        // 2.Full years: exact for non-negative diff (d / 12.0 never rounds up to next integer)
+        const __m256d years_vec =
+            _mm256_floor_pd(_mm256_div_pd(_mm256_cvtepi32_pd(diff_vec), twelve_vec));
+
+        // 3.Salary with bonus (the same operations order as in `seniority_salary`)
+        const __m256d base_vec  = _mm256_loadu_pd(base_salaries + i);
+        const __m256d rate_vec  = _mm256_loadu_pd(rates + i);
+        const __m256d cap_vec   = _mm256_loadu_pd(caps + i);
+        const __m256d bonus_vec = _mm256_min_pd(
+            _mm256_mul_pd(cap_vec, base_vec),
+            _mm256_mul_pd(_mm256_mul_pd(rate_vec, years_vec), base_vec));
+
+        const __m256d fired_mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(fired_vec));
+        const __m256d salary_vec =
+            _mm256_blendv_pd(_mm256_add_pd(base_vec, bonus_vec), zero_vec, fired_mask);
+
+        _mm256_storeu_pd(salaries + i, salary_vec);
+
+        const int fired_bits = _mm256_movemask_pd(fired_mask);
+        for (size_t k = 0; k < 4; ++k) {
+            hired[i + k] = ((fired_bits >> k) & 1) == 0;
+        }
+    }
+
+    calculate_seniority_salaries_scalar(count - i, hire_months + i, base_salaries + i, rates + i,
+                                        caps + i, month, salaries + i, hired + i);
+}
+
+#endif
+
+} // namespace
+
+//! Calculate salaries of employees taking into account bonus for long service only
+void employee::calculate_seniority_salaries(size_t         count,
+                                            const month_t* hire_months,
+                                            const double*  base_salaries,
+                                            const double*  rates,
+                                            const double*  caps,
+                                            month_t        month,
+                                            double*        salaries,
+                                            uint8_t*       hired) {
+#ifdef EMPLOYEE_LIB_HAS_AVX2_KERNEL
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) {
+        calculate_seniority_salaries_avx2(
+            count, hire_months, base_salaries, rates, caps, month, salaries, hired);
+        return;
+    }
+#endif
+
+    calculate_seniority_salaries_scalar(
+        count, hire_months, base_salaries, rates, caps, month, salaries, hired);
+}
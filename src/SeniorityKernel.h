@@ -0,0 +1,52 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/Month.h>
+
+// C++ includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace employee
+{
+
+/**
+ * @brief Calculate salary of one employee taking into account bonus for long service only
+ * @param base_salary base salary
+ * @param rate bonus rate for every full year of service
+ * @param cap bonus cap (rate of base salary)
+ * @param full_years full years of service
+ * @return salary with seniority bonus
+ */
+inline double seniority_salary(double base_salary, double rate, double cap, int full_years) {
+    return base_salary + std::min(cap * base_salary, rate * full_years * base_salary);
+}
+
+/**
+ * @brief Calculate salaries of employees taking into account bonus for long service only
+ * (batch kernel: vectorized with AVX2 if CPU supports it, scalar otherwise)
+ *
+ * For every employee `i`:
+ * - hired[i] = month >= hire_months[i];
+ * - salaries[i] = seniority_salary(...) if hired, 0.0 otherwise.
+ *
+ * @param count number of employees
+ * @param hire_months hire months (contiguous array)
+ * @param base_salaries base salaries (contiguous array)
+ * @param rates bonus rates for every full year of service (contiguous array)
+ * @param caps bonus caps (contiguous array)
+ * @param month month of salary payment
+ * @param salaries calculated salaries (output array)
+ * @param hired hired flags (output array)
+ */
+void calculate_seniority_salaries(size_t         count,
+                                  const month_t* hire_months,
+                                  const double*  base_salaries,
+                                  const double*  rates,
+                                  const double*  caps,
+                                  month_t        month,
+                                  double*        salaries,
+                                  uint8_t*       hired);
+
+} // namespace employee
@@ -0,0 +1,144 @@
+// relative includes
+#include "ShardedEmployeeStorage.h"
+
+// boost includes
+#include <boost/functional/hash.hpp>
+
+// C++ includes
+#include <algorithm>
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+//! Construct an empty storage
+ShardedEmployeeStorage::ShardedEmployeeStorage(size_t                     shards_count,
+                                               std::pmr::memory_resource* upstream) :
+    upstream_(upstream != nullptr ? std::make_unique<SynchronizedResource>(upstream) : nullptr) {
+    shards_count = std::max<size_t>(shards_count, 1);
+
+    shards_.reserve(shards_count);
+    for (size_t i = 0; i < shards_count; ++i) {
+        shards_.push_back(std::make_unique<Shard>(upstream_.get()));
+    }
+}
+
+//! Destruct storage together with all columns
+ShardedEmployeeStorage::~ShardedEmployeeStorage() = default;
+
+//! Get number of shards
+size_t ShardedEmployeeStorage::shards_count() const {
+    return shards_.size();
+}
+
+//! Get index of shard of employee
+size_t ShardedEmployeeStorage::shard_index(const uuid_t& id) const {
+    // Pay attention: storage of shard hashes identifiers by the same function, so shard is chosen
+    // by high bits of mixed hash (otherwise all keys of shard would fall into the same buckets)
+    const uint64_t hash = static_cast<uint64_t>(boost::hash<uuid_t>{}(id));
+
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> 32) % shards_.size();
+}
+
+//! Get shard by index
+ShardedEmployeeStorage::Shard& ShardedEmployeeStorage::shard(size_t index) {
+    return *shards_[index];
+}
+
+//! Get shard by index
+const ShardedEmployeeStorage::Shard& ShardedEmployeeStorage::shard(size_t index) const {
+    return *shards_[index];
+}
+
+//! Get shard of employee
+ShardedEmployeeStorage::Shard& ShardedEmployeeStorage::shard(const uuid_t& id) {
+    return *shards_[shard_index(id)];
+}
+
+//! Register employee
+bool ShardedEmployeeStorage::emplace(const EmployeeDescr& description, const uuid_t& id) {
+    Shard&                              shard = this->shard(id);
+    std::unique_lock<std::shared_mutex> lock(shard.mtx);
+
+    return shard.storage.emplace(description, id) != EmployeeStorage::NONE;
+}
+
+//! Unregister employee
+bool ShardedEmployeeStorage::erase(const uuid_t& id) {
+    Shard&                              shard = this->shard(id);
+    std::unique_lock<std::shared_mutex> lock(shard.mtx);
+
+    return shard.storage.erase(id);
+}
+
+//! Reserve columns of all shards for given total number of employees
+void ShardedEmployeeStorage::reserve(size_t count) {
+    // Hash spreads employees evenly, a small margin covers deviation
+    const size_t per_shard = count / shards_.size() + count / (8 * shards_.size()) + 1;
+
+    for (const auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard->mtx);
+        shard->storage.reserve(per_shard);
+    }
+}
+
+//! Check if employee is registered
+bool ShardedEmployeeStorage::contains(const uuid_t& id) const {
+    const Shard&                        shard = *shards_[shard_index(id)];
+    std::shared_lock<std::shared_mutex> lock(shard.mtx);
+
+    return shard.storage.find_slot(id) != EmployeeStorage::NONE;
+}
+
+//! Find employee category
+std::optional<EmployeeType> ShardedEmployeeStorage::find_type(const uuid_t& id) const {
+    const Shard&                        shard = *shards_[shard_index(id)];
+    std::shared_lock<std::shared_mutex> lock(shard.mtx);
+
+    const uint32_t slot = shard.storage.find_slot(id);
+    if (slot == EmployeeStorage::NONE) {
+        return std::nullopt;
+    }
+
+    return shard.storage.types()[slot];
+}
+
+//! Find employee description
+std::optional<EmployeeDescr> ShardedEmployeeStorage::find(const uuid_t& id) const {
+    const Shard&                        shard = *shards_[shard_index(id)];
+    std::shared_lock<std::shared_mutex> lock(shard.mtx);
+
+    return shard.storage.find(id);
+}
+
+//! Get number of employees of all shards
+uint32_t ShardedEmployeeStorage::size() const {
+    uint32_t size = 0;
+
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard->mtx);
+        size += shard->storage.size();
+    }
+
+    return size;
+}
+
+//! Allocate memory from upstream resource
+void* ShardedEmployeeStorage::SynchronizedResource::do_allocate(size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return upstream_->allocate(bytes, alignment);
+}
+
+//! Return memory to upstream resource
+void ShardedEmployeeStorage::SynchronizedResource::do_deallocate(void*  p,
+                                                                 size_t bytes,
+                                                                 size_t alignment) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    upstream_->deallocate(p, bytes, alignment);
+}
+
+//! Compare with other resource
+bool ShardedEmployeeStorage::SynchronizedResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+
+// boost includes
+#include <boost/uuid/uuid.hpp>
+
+// relative includes
+#include "EmployeeStorage.h"
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class ShardedEmployeeStorage
+ * @brief Class that partitions employees storage into independently locked shards by hash of
+ * unique identifier
+ *
+ * Every shard is a separate `EmployeeStorage` (with its own columns) guarded by its
+ * own mutex, so registrations and removals of employees of different shards run in parallel.
+ * Methods below lock shard of employee by themselves; code that must keep shard locked over
+ * several steps (e.g. to write change journal in order of changes) locks `Shard::mtx` directly.
+ */
+class ShardedEmployeeStorage {
+public:
+    /**
+     * @struct Shard
+     * @brief Partition of storage (aligned to cache line, so locks of shards do not share it)
+     */
+    struct alignas(64) Shard {
+        explicit Shard(std::pmr::memory_resource* upstream) : storage(upstream) {}
+
+        mutable std::shared_mutex mtx;     //!< Guards storage of shard
+        EmployeeStorage           storage; //!< Employees of shard
+    };
+
+    ShardedEmployeeStorage() = delete;
+
+    ShardedEmployeeStorage(const ShardedEmployeeStorage& other)  = delete;
+    ShardedEmployeeStorage(const ShardedEmployeeStorage&& other) = delete;
+
+    ShardedEmployeeStorage& operator=(const ShardedEmployeeStorage& other)  = delete;
+    ShardedEmployeeStorage& operator=(const ShardedEmployeeStorage&& other) = delete;
+
+    /**
+     * @brief Construct an empty storage
+     * @param shards_count number of shards (at least one)
+     * @param upstream memory resource for columns (nullptr for default one); it is
+     * called by shards under a common lock, so it does not need to be thread-safe
+     */
+    ShardedEmployeeStorage(size_t shards_count, std::pmr::memory_resource* upstream);
+
+    /**
+     * @brief Destruct storage together with all columns
+     */
+    ~ShardedEmployeeStorage();
+
+    /**
+     * @brief Get number of shards
+     */
+    size_t shards_count() const;
+
+    /**
+     * @brief Get index of shard of employee
+     * @param id employee unique identifier
+     * @return shard index
+     */
+    size_t shard_index(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get shard by index
+     * @param index shard index
+     * @return shard
+     */
+    Shard& shard(size_t index);
+
+    /**
+     * @brief Get shard by index
+     * @param index shard index
+     * @return shard
+     */
+    const Shard& shard(size_t index) const;
+
+    /**
+     * @brief Get shard of employee
+     * @param id employee unique identifier
+     * @return shard
+     */
+    Shard& shard(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Register employee
+     * @param description employee description
+     * @param id employee unique identifier
+     * @return was registered or not (unknown category or already registered identifier)
+     */
+    bool emplace(const EmployeeDescr& description, const boost::uuids::uuid& id);
+
+    /**
+     * @brief Unregister employee
+     * @param id employee unique identifier
+     * @return was erased or not
+     */
+    bool erase(const boost::uuids::uuid& id);
+
+    /**
+     * @brief Reserve columns of all shards for given total number of employees
+     * @param count total number of employees
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Check if employee is registered
+     * @param id employee unique identifier
+     * @return is registered or not
+     */
+    bool contains(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Find employee category
+     * @param id employee unique identifier
+     * @return category (nullopt if there is no such employee)
+     */
+    std::optional<EmployeeType> find_type(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Find employee description (copy taken under lock of shard)
+     * @param id employee unique identifier
+     * @return description (nullopt if there is no such employee)
+     */
+    std::optional<EmployeeDescr> find(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get number of employees of all shards
+     */
+    uint32_t size() const;
+
+private:
+    /**
+     * @class SynchronizedResource
+     * @brief Memory resource that serializes calls of upstream one (shared by all shards)
+     */
+    class SynchronizedResource : public std::pmr::memory_resource {
+    public:
+        explicit SynchronizedResource(std::pmr::memory_resource* upstream) :
+            upstream_(upstream) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void  do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        std::mutex                 mtx_;      //!< Serializes calls of upstream resource
+        std::pmr::memory_resource* upstream_; //!< Upstream resource
+    };
+
+    std::unique_ptr<SynchronizedResource> upstream_; //!< Upstream resource of shards (optional)
+    std::vector<std::unique_ptr<Shard>>   shards_;   //!< Shards
+};
+
+} // namespace employee
@@ -0,0 +1,192 @@
+// relative includes
+#include "Snapshot.h"
+#include "RegistryFile.h"
+#include "RegistryVersion.h"
+
+// C++ includes
+#include <algorithm>
+#include <cassert>
+
+using namespace employee;
+
+using uuid_t = boost::uuids::uuid;
+
+//! Construct snapshot of registry version
+Snapshot::Snapshot(const RegistryVersion& registry) :
+    version_(registry.version()), size_(registry.size()) {
+    const uint32_t count = size_;
+
+    owned_ids_.resize(count);
+    owned_types_.resize(count);
+    owned_base_salaries_.resize(count);
+    owned_hire_months_.resize(count);
+    owned_hire_days_.resize(count);
+    owned_chiefs_.resize(count);
+    owned_subtree_ends_.resize(count);
+    index_.reserve(count);
+
+    // 1.Pre-order of hierarchy forest: top-level employees in order of registry, subordinates in
+    // order of lists of their chiefs
+    std::vector<std::pair<uuid_t, uint32_t>> tower; // Employee and index of his chief
+
+    uint32_t position = 0;
+    registry.for_each([&](const uuid_t& root, const RegistryVersion::Record& root_record) {
+        if (!root_record.chief.is_nil()) {
+            return;
+        }
+
+        tower.emplace_back(root, NONE);
+        while (!tower.empty()) {
+            const auto [id, chief] = tower.back();
+            tower.pop_back();
+
+            const RegistryVersion::Record& record = *registry.find(id);
+
+            owned_ids_[position]           = id;
+            owned_types_[position]         = static_cast<uint8_t>(record.type);
+            owned_base_salaries_[position] = record.base_salary;
+            owned_hire_months_[position]   = record.hire_month;
+            owned_hire_days_[position]     = record.hire_day;
+            owned_chiefs_[position]        = chief;
+            owned_subtree_ends_[position]  = position + 1 + record.subtree_size;
+            index_.emplace(id, position);
+
+            if (record.subordinates != nullptr) {
+                for (auto it = record.subordinates->rbegin(); it != record.subordinates->rend();
+                     ++it) {
+                    tower.emplace_back(*it, position);
+                }
+            }
+
+            ++position;
+        }
+    });
+
+    assert(position == count);
+
+    // 2.Columns
+    ids_           = owned_ids_.data();
+    types_         = owned_types_.data();
+    base_salaries_ = owned_base_salaries_.data();
+    hire_months_   = owned_hire_months_.data();
+    hire_days_     = owned_hire_days_.data();
+    chiefs_        = owned_chiefs_.data();
+    subtree_ends_  = owned_subtree_ends_.data();
+    id_index_      = nullptr;
+}
+
+//! Construct snapshot over columns of mapped registry file
+Snapshot::Snapshot(uint64_t version, std::shared_ptr<const MappedRegistryFile> file) :
+    version_(version),
+    size_(file->size()),
+    ids_(file->ids()),
+    types_(file->types()),
+    base_salaries_(file->base_salaries()),
+    hire_months_(file->hire_months()),
+    hire_days_(file->hire_days()),
+    chiefs_(file->chiefs()),
+    subtree_ends_(file->subtree_ends()),
+    id_index_(file->id_index()),
+    file_(std::move(file)) {}
+
+//! Get version of source data
+uint64_t Snapshot::version() const {
+    return version_;
+}
+
+//! Get number of employees
+uint32_t Snapshot::size() const {
+    return size_;
+}
+
+//! Find employee index by his unique identifier
+std::optional<uint32_t> Snapshot::find(const uuid_t& id) const {
+    // Mapped columns: binary search over indices ordered by identifiers
+    if (id_index_ != nullptr) {
+        const uint32_t* it = std::lower_bound(
+            id_index_, id_index_ + size_, id,
+            [this](uint32_t index, const uuid_t& value) -> bool { return ids_[index] < value; });
+        if (it == id_index_ + size_ || ids_[*it] != id) {
+            return std::nullopt;
+        }
+
+        return *it;
+    }
+
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+//! Get employee unique identifier
+const uuid_t& Snapshot::id(uint32_t i) const {
+    return ids_[i];
+}
+
+//! Get employee type
+EmployeeType Snapshot::type(uint32_t i) const {
+    return static_cast<EmployeeType>(types_[i]);
+}
+
+//! Get employee base salary
+double Snapshot::base_salary(uint32_t i) const {
+    return base_salaries_[i];
+}
+
+//! Get employee hire month
+month_t Snapshot::hire_month(uint32_t i) const {
+    return hire_months_[i];
+}
+
+//! Get day of employee hire date
+uint8_t Snapshot::hire_day(uint32_t i) const {
+    return hire_days_[i];
+}
+
+//! Get column of unique identifiers
+const uuid_t* Snapshot::ids() const {
+    return ids_;
+}
+
+//! Get column of categories
+const uint8_t* Snapshot::types() const {
+    return types_;
+}
+
+//! Get column of base salaries
+const double* Snapshot::base_salaries() const {
+    return base_salaries_;
+}
+
+//! Get column of hire months
+const month_t* Snapshot::hire_months() const {
+    return hire_months_;
+}
+
+//! Get column of days of hire dates
+const uint8_t* Snapshot::hire_days() const {
+    return hire_days_;
+}
+
+//! Get chief index
+uint32_t Snapshot::chief(uint32_t i) const {
+    return chiefs_[i];
+}
+
+//! Get column of chiefs indices
+const uint32_t* Snapshot::chiefs() const {
+    return chiefs_;
+}
+
+//! Get end (exclusive) of employee subtree range
+uint32_t Snapshot::subtree_end(uint32_t i) const {
+    return subtree_ends_[i];
+}
+
+//! Get column of subtree ranges ends
+const uint32_t* Snapshot::subtree_ends() const {
+    return subtree_ends_;
+}
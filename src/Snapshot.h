@@ -0,0 +1,177 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeDescr.h>
+#include <employee_lib/Month.h>
+
+// boost includes
+#include <boost/unordered_map.hpp>
+#include <boost/uuid/uuid.hpp>
+
+// C++ includes
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace employee
+{
+
+class MappedRegistryFile;
+class RegistryVersion;
+
+/**
+ * @class Snapshot
+ * @brief Immutable versioned copy of employees storage together with hierarchy
+ *
+ * Employees are stored in hierarchy pre-order, so:
+ * - subtree of employee `i` is the contiguous range [i, subtree_end(i));
+ * - every subordinate has greater index than his chiefs (reverse scan is a post-order one).
+ *
+ * Snapshot is never modified after construction, so it is read without any lock.
+ *
+ * Columns are either owned by snapshot (snapshot built from registry version) or belong to mapped
+ * registry file (snapshot is served from mapping in place, employees are found by binary search
+ * over ordered indices of file instead of hash index).
+ */
+class Snapshot {
+public:
+    //!< Index value for absent employee (e.g. chief of top-level employee)
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    Snapshot() = delete;
+
+    Snapshot(const Snapshot& other)  = delete;
+    Snapshot(const Snapshot&& other) = delete;
+
+    Snapshot& operator=(const Snapshot& other)  = delete;
+    Snapshot& operator=(const Snapshot&& other) = delete;
+
+    /**
+     * @brief Construct snapshot of registry version (of the same version)
+     * @param registry registry version
+     */
+    explicit Snapshot(const RegistryVersion& registry);
+
+    /**
+     * @brief Construct snapshot over columns of mapped registry file (without copying)
+     * @param version version of source data
+     * @param file mapped registry file (kept mapped while snapshot exists)
+     */
+    Snapshot(uint64_t version, std::shared_ptr<const MappedRegistryFile> file);
+
+    /**
+     * @brief Get version of source data
+     */
+    uint64_t version() const;
+
+    /**
+     * @brief Get number of employees
+     */
+    uint32_t size() const;
+
+    /**
+     * @brief Find employee index by his unique identifier
+     * @param id employee unique identifier
+     * @return employee index (optional value)
+     */
+    std::optional<uint32_t> find(const boost::uuids::uuid& id) const;
+
+    /**
+     * @brief Get employee unique identifier
+     */
+    const boost::uuids::uuid& id(uint32_t i) const;
+
+    /**
+     * @brief Get employee type
+     */
+    EmployeeType type(uint32_t i) const;
+
+    /**
+     * @brief Get employee base salary
+     */
+    double base_salary(uint32_t i) const;
+
+    /**
+     * @brief Get employee hire month
+     */
+    month_t hire_month(uint32_t i) const;
+
+    /**
+     * @brief Get day of employee hire date
+     */
+    uint8_t hire_day(uint32_t i) const;
+
+    /**
+     * @brief Get column of unique identifiers (pre-order)
+     */
+    const boost::uuids::uuid* ids() const;
+
+    /**
+     * @brief Get column of categories (pre-order, `EmployeeType` values)
+     */
+    const uint8_t* types() const;
+
+    /**
+     * @brief Get column of base salaries (pre-order)
+     */
+    const double* base_salaries() const;
+
+    /**
+     * @brief Get column of hire months (pre-order)
+     */
+    const month_t* hire_months() const;
+
+    /**
+     * @brief Get column of days of hire dates (pre-order)
+     */
+    const uint8_t* hire_days() const;
+
+    /**
+     * @brief Get chief index (`NONE` for top-level employee)
+     */
+    uint32_t chief(uint32_t i) const;
+
+    /**
+     * @brief Get column of chiefs indices (pre-order)
+     */
+    const uint32_t* chiefs() const;
+
+    /**
+     * @brief Get end (exclusive) of employee subtree range
+     */
+    uint32_t subtree_end(uint32_t i) const;
+
+    /**
+     * @brief Get column of subtree ranges ends (pre-order)
+     */
+    const uint32_t* subtree_ends() const;
+
+private:
+    uint64_t version_; //!< Version of source data
+    uint32_t size_;    //!< Number of employees
+
+    const boost::uuids::uuid* ids_;           //!< Unique identifiers
+    const uint8_t*            types_;         //!< Categories
+    const double*             base_salaries_; //!< Base salaries
+    const month_t*            hire_months_;   //!< Hire months
+    const uint8_t*            hire_days_;     //!< Days of hire dates
+    const uint32_t*           chiefs_;        //!< Chiefs indices
+    const uint32_t*           subtree_ends_;  //!< Ends of subtree ranges
+    const uint32_t*           id_index_;      //!< Indices ordered by identifiers (mapped only)
+
+    std::vector<boost::uuids::uuid> owned_ids_;           //!< Owned unique identifiers
+    std::vector<uint8_t>            owned_types_;         //!< Owned categories
+    std::vector<double>             owned_base_salaries_; //!< Owned base salaries
+    std::vector<month_t>            owned_hire_months_;   //!< Owned hire months
+    std::vector<uint8_t>            owned_hire_days_;     //!< Owned days of hire dates
+    std::vector<uint32_t>           owned_chiefs_;        //!< Owned chiefs indices
+    std::vector<uint32_t>           owned_subtree_ends_;  //!< Owned ends of subtree ranges
+
+    //!< Relation "unique identifier-->index" (owned columns only)
+    boost::unordered_map<boost::uuids::uuid, uint32_t> index_;
+
+    std::shared_ptr<const MappedRegistryFile> file_; //!< Mapped registry file (optional)
+};
+
+} // namespace employee
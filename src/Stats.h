@@ -0,0 +1,216 @@
+#pragma once
+
+// lib includes
+#include <employee_lib/EmployeeManagerStats.h>
+
+// C++ includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+namespace employee
+{
+
+#ifdef EMPLOYEE_LIB_STATS
+//!< Statistics are collected (library is built with `EMPLOYEE_LIB_STATS` option)
+constexpr bool STATS_ENABLED = true;
+#else
+//!< Statistics are not collected (instrumentation is compiled out)
+constexpr bool STATS_ENABLED = false;
+#endif
+
+/**
+ * @class BasicHistogramRecorder
+ * @brief Class of thread-safe histogram recorder (relaxed atomic counters, no locks)
+ */
+template<bool ENABLED>
+class BasicHistogramRecorder {
+public:
+    /**
+     * @brief Record value
+     * @param value value
+     */
+    void record(uint64_t value) {
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+        buckets_[Histogram::bucket(value)].fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Read recorded values (concurrent recording may be partially taken into account)
+     * @return histogram
+     */
+    Histogram read() const {
+        Histogram histogram;
+        histogram.count = count_.load(std::memory_order_relaxed);
+        histogram.sum   = sum_.load(std::memory_order_relaxed);
+        histogram.max   = max_.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < Histogram::BUCKETS_COUNT; ++i) {
+            histogram.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        }
+
+        return histogram;
+    }
+
+private:
+    std::atomic<uint64_t> count_{0}; //!< Number of values
+    std::atomic<uint64_t> sum_{0};   //!< Sum of values
+    std::atomic<uint64_t> max_{0};   //!< The largest value
+
+    std::array<std::atomic<uint64_t>, Histogram::BUCKETS_COUNT> buckets_{}; //!< Buckets counters
+};
+
+/**
+ * @class BasicHistogramRecorder
+ * @brief Class of histogram recorder without statistics (every call is compiled out)
+ */
+template<>
+class BasicHistogramRecorder<false> {
+public:
+    void record(uint64_t) {}
+
+    Histogram read() const {
+        return {};
+    }
+};
+
+//!< Histogram recorder of actual build
+using HistogramRecorder = BasicHistogramRecorder<STATS_ENABLED>;
+
+/**
+ * @class LockRecorder
+ * @brief Class of statistics recorder of shared mutex
+ */
+struct LockRecorder {
+    HistogramRecorder shared_wait; //!< Waiting for shared lock
+    HistogramRecorder shared_hold; //!< Holding of shared lock
+    HistogramRecorder unique_wait; //!< Waiting for unique lock
+    HistogramRecorder unique_hold; //!< Holding of unique lock
+
+    /**
+     * @brief Read recorded statistics
+     * @return lock statistics
+     */
+    LockStats read() const {
+        return {shared_wait.read(), shared_hold.read(), unique_wait.read(), unique_hold.read()};
+    }
+};
+
+/**
+ * @brief Get nanoseconds since time point
+ * @param start time point
+ * @return nanoseconds
+ */
+inline uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+
+/**
+ * @class ScopedTimer
+ * @brief Class that records duration of its scope (nothing is done without statistics)
+ */
+class ScopedTimer {
+public:
+    ScopedTimer(const ScopedTimer& other)  = delete;
+    ScopedTimer(const ScopedTimer&& other) = delete;
+
+    ScopedTimer& operator=(const ScopedTimer& other)  = delete;
+    ScopedTimer& operator=(const ScopedTimer&& other) = delete;
+
+    /**
+     * @brief Start timer
+     * @param recorder recorder of duration
+     */
+    explicit ScopedTimer(HistogramRecorder& recorder) : recorder_(recorder) {
+        if constexpr (STATS_ENABLED) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * @brief Record duration
+     */
+    ~ScopedTimer() {
+        if constexpr (STATS_ENABLED) {
+            recorder_.record(elapsed_ns(start_));
+        }
+    }
+
+private:
+    HistogramRecorder&                    recorder_; //!< Recorder of duration
+    std::chrono::steady_clock::time_point start_;    //!< Start of scope
+};
+
+/**
+ * @class TimedLock
+ * @brief Class of lock of shared mutex (`std::shared_lock` or `std::unique_lock`) that records
+ * waiting and holding times (it is a plain lock without statistics)
+ */
+template<typename Lock>
+class TimedLock : public Lock {
+public:
+    //!< Lock is shared one
+    static constexpr bool SHARED = std::is_same_v<Lock, std::shared_lock<std::shared_mutex>>;
+
+    TimedLock(const TimedLock& other)  = delete;
+    TimedLock(const TimedLock&& other) = delete;
+
+    TimedLock& operator=(const TimedLock& other)  = delete;
+    TimedLock& operator=(const TimedLock&& other) = delete;
+
+    /**
+     * @brief Lock mutex
+     * @param mtx mutex
+     * @param recorder recorder of mutex statistics
+     */
+    TimedLock(std::shared_mutex& mtx, LockRecorder& recorder) :
+        Lock(mtx, std::defer_lock), recorder_(recorder) {
+        if constexpr (STATS_ENABLED) {
+            const auto start = std::chrono::steady_clock::now();
+            Lock::lock();
+
+            acquired_ = std::chrono::steady_clock::now();
+            (SHARED ? recorder_.shared_wait : recorder_.unique_wait)
+                .record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(acquired_ - start)
+                        .count()));
+        } else {
+            Lock::lock();
+        }
+    }
+
+    /**
+     * @brief Record holding time and unlock mutex
+     */
+    ~TimedLock() {
+        if constexpr (STATS_ENABLED) {
+            if (Lock::owns_lock()) {
+                (SHARED ? recorder_.shared_hold : recorder_.unique_hold)
+                    .record(elapsed_ns(acquired_));
+            }
+        }
+    }
+
+private:
+    LockRecorder&                         recorder_; //!< Recorder of mutex statistics
+    std::chrono::steady_clock::time_point acquired_; //!< Moment of locking
+};
+
+//!< Shared lock with statistics
+using TimedSharedLock = TimedLock<std::shared_lock<std::shared_mutex>>;
+
+//!< Unique lock with statistics
+using TimedUniqueLock = TimedLock<std::unique_lock<std::shared_mutex>>;
+
+} // namespace employee
@@ -0,0 +1,197 @@
+// relative includes
+#include "ThreadPool.h"
+
+// C++ includes
+#include <algorithm>
+
+using employee::ThreadPool;
+
+namespace
+{
+
+//! Pool and queue index of current worker thread
+thread_local const ThreadPool* current_pool  = nullptr;
+thread_local size_t            current_index = 0;
+
+//! Get sequence number of current thread (assigned by the first call)
+size_t thread_sequence() {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t  sequence = next++;
+
+    return sequence;
+}
+
+} // namespace
+
+//! Construct pool and start workers
+ThreadPool::ThreadPool(size_t threads) : stop_(false) {
+    // Queues of workers, then injection queues of non-worker threads (as many as workers)
+    const size_t injection_queues = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads + injection_queues; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+//! Stop workers and destruct pool
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+//! Get number of workers
+size_t ThreadPool::size() const {
+    return workers_.size();
+}
+
+//! Run parallel loop and wait until all its iterations are done
+void ThreadPool::run(size_t count, const Body& body) {
+    if (count == 0) {
+        return;
+    }
+
+    const size_t index = queue_index();
+
+    Loop loop;
+    loop.body    = &body;
+    loop.pending = count;
+
+    // 1.Publish all iterations except the first one (it is executed by calling thread)
+    {
+        // Pay attention: counter is increased before tasks become visible, so thieves never
+        // decrease it below zero
+        std::lock_guard<std::mutex> lock(queues_[index]->mtx);
+
+        queued_ += count - 1;
+        for (size_t i = count; i > 1; --i) {
+            queues_[index]->tasks.push_back({&loop, i - 1});
+        }
+    }
+    wake_all();
+
+    execute(loop, 0);
+    --loop.pending;
+
+    // 2.Help others while waiting: tasks of this loop can be stolen by anybody, so when there is
+    // nothing to execute, sleep until the last iteration is done or new tasks are queued
+    while (loop.pending != 0) {
+        if (execute_one(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mtx_);
+        sleep_cv_.wait(lock, [this, &loop]() { return loop.pending == 0 || queued_ != 0; });
+    }
+
+    // 3.No task refers to the loop anymore, so its error can be thrown
+    if (loop.error) {
+        std::rethrow_exception(loop.error);
+    }
+}
+
+//! Worker thread function
+void ThreadPool::work(size_t index) {
+    current_pool  = this;
+    current_index = index;
+
+    while (true) {
+        if (execute_one(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mtx_);
+        sleep_cv_.wait(lock, [this]() { return stop_ || queued_ != 0; });
+
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+//! Execute one task of own queue or steal one from other queues
+bool ThreadPool::execute_one(size_t index) {
+    Task task{};
+    bool found = false;
+
+    // 1.Own queue: the most recent task
+    {
+        Queue&                      own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mtx);
+
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // 2.Other queues: the oldest task
+    for (size_t i = 1; !found && i < queues_.size(); ++i) {
+        Queue&                      victim = *queues_[(index + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    --queued_;
+
+    execute(*task.loop, task.index);
+
+    // Pay attention: the last iteration releases thread waiting for the loop (the loop may be
+    // destroyed right after decrement, so only members of pool are accessed)
+    if (--task.loop->pending == 0) {
+        wake_all();
+    }
+
+    return true;
+}
+
+//! Execute iteration of loop
+void ThreadPool::execute(Loop& loop, size_t index) {
+    try {
+        (*loop.body)(index);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(loop.mtx);
+        if (!loop.error) {
+            loop.error = std::current_exception();
+        }
+    }
+}
+
+//! Get queue index of calling thread
+size_t ThreadPool::queue_index() const {
+    if (current_pool == this) {
+        return current_index;
+    }
+
+    const size_t injection_queues = queues_.size() - workers_.size();
+    return workers_.size() + thread_sequence() % injection_queues;
+}
+
+//! Wake sleeping threads up
+void ThreadPool::wake_all() {
+    // Pass through mutex, so no thread misses the wake up between its check and wait
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx_);
+    }
+    sleep_cv_.notify_all();
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+// C++ includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace employee
+{
+
+/**
+ * @class ThreadPool
+ * @brief Class of fork-join thread pool with work stealing
+ *
+ * Every worker has its own tasks queue: it takes its own tasks from the back (the most recent
+ * ones, whose data are hot in cache) and steals tasks of other workers from the front (the
+ * oldest ones, which are usually the biggest). Threads that are waiting for their tasks execute
+ * other tasks meanwhile, so tasks can run nested parallel loops without deadlock, and sleep when
+ * there is nothing to execute.
+ *
+ * Non-worker threads publish their tasks to injection queues: every such thread is bound to one
+ * of them by its sequence number, so concurrent submitters don't contend for a single queue.
+ */
+class ThreadPool {
+public:
+    //!< Body of parallel loop (called with index of iteration)
+    using Body = std::function<void(size_t)>;
+
+    ThreadPool() = delete;
+
+    ThreadPool(const ThreadPool& other)  = delete;
+    ThreadPool(const ThreadPool&& other) = delete;
+
+    ThreadPool& operator=(const ThreadPool& other)  = delete;
+    ThreadPool& operator=(const ThreadPool&& other) = delete;
+
+    /**
+     * @brief Construct pool and start workers
+     * @param threads number of workers
+     */
+    explicit ThreadPool(size_t threads);
+
+    /**
+     * @brief Stop workers and destruct pool
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Get number of workers
+     */
+    size_t size() const;
+
+    /**
+     * @brief Run parallel loop and wait until all its iterations are done (calling thread
+     * executes iterations too)
+     * @param count number of iterations
+     * @param body body of loop
+     * Attention! If iterations throw, the first exception is rethrown only after all iterations
+     * are done (queued tasks refer to the loop, so it must not be left earlier).
+     */
+    void run(size_t count, const Body& body);
+
+private:
+    /**
+     * @struct Loop
+     * @brief State of parallel loop (lives on stack of thread waiting for it)
+     */
+    struct Loop {
+        const Body*         body;    //!< Body of loop
+        std::atomic<size_t> pending; //!< Number of not finished iterations
+        std::mutex          mtx;     //!< Guards error
+        std::exception_ptr  error;   //!< The first exception thrown by iterations (optional)
+    };
+
+    /**
+     * @struct Task
+     * @brief One iteration of parallel loop
+     */
+    struct Task {
+        Loop*  loop;  //!< Parallel loop
+        size_t index; //!< Index of iteration
+    };
+
+    /**
+     * @struct Queue
+     * @brief Tasks queue of one worker
+     */
+    struct Queue {
+        std::mutex       mtx;   //!< Mutex for threads sync
+        std::deque<Task> tasks; //!< Tasks
+    };
+
+    /**
+     * @brief Worker thread function
+     * @param index worker index
+     */
+    void work(size_t index);
+
+    /**
+     * @brief Execute one task of own queue or steal one from other queues
+     * @param index queue index of calling thread
+     * @return task was executed or not
+     */
+    bool execute_one(size_t index);
+
+    /**
+     * @brief Execute iteration of loop (exception is kept by loop instead of propagation)
+     * @param loop parallel loop
+     * @param index index of iteration
+     */
+    static void execute(Loop& loop, size_t index);
+
+    /**
+     * @brief Get queue index of calling thread (injection queue bound to non-worker thread)
+     */
+    size_t queue_index() const;
+
+    /**
+     * @brief Wake sleeping threads up (idle workers and threads waiting for their loops)
+     */
+    void wake_all();
+
+private:
+    std::vector<std::thread>            workers_; //!< Workers
+    std::vector<std::unique_ptr<Queue>> queues_;  //!< Queues of workers, then injection queues
+
+    std::atomic<size_t>     queued_{0}; //!< Number of queued tasks
+    std::mutex              sleep_mtx_; //!< Mutex for sleeping threads
+    std::condition_variable sleep_cv_;  //!< Wakes sleeping threads up
+    bool                    stop_;      //!< Workers must exit
+};
+
+} // namespace employee
@@ -3,19 +3,40 @@
 
 // lib includes
 #include <employee_lib/EmployeeManager.h>
+#include <employee_lib/EmployeeRegistryView.h>
 
 // boost includes
+#include <boost/uuid/name_generator_sha1.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 
 // C++ includes
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory_resource>
 #include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
 #include <tuple>
 
+using employee::CategoryPayroll;
 using employee::date_t;
 using employee::EmployeeDescr;
 using employee::EmployeeManager;
+using employee::EmployeeManagerStats;
+using employee::EmployeeRegistryView;
 using employee::EmployeeType;
+using employee::HierarchyTraversal;
+using employee::Histogram;
+using employee::ManagerOperation;
+using employee::PayrollByType;
+using employee::SalaryPolicy;
 using employee::uuid_t;
 
 namespace bg = boost::gregorian;
@@ -52,6 +73,130 @@ TEST(main_suite, add_employee) {
     EXPECT_TRUE(id1 != id2);
 }
 
+TEST(main_suite, add_employee_with_id) {
+    EmployeeManager manager{};
+
+    // 1.Caller-supplied identifiers
+    const uuid_t id = __generate_uuid();
+    EXPECT_FALSE(manager.add_employee(uuid_t{}, WORKER_DESCR));
+    EXPECT_TRUE(manager.add_employee(id, WORKER_DESCR));
+    EXPECT_FALSE(manager.add_employee(id, MANAGER_DESCR));
+    EXPECT_EQ(manager.find_employee(id)->type, WORKER_DESCR.type);
+
+    // 2.Batch with repeated or already registered identifiers: nothing is added
+    const uuid_t id_1 = __generate_uuid();
+    const uuid_t id_2 = __generate_uuid();
+    EXPECT_FALSE(manager.add_employees({id_1, id_1}, {WORKER_DESCR, WORKER_DESCR}));
+    EXPECT_FALSE(manager.add_employees({id_1, id}, {WORKER_DESCR, WORKER_DESCR}));
+    EXPECT_FALSE(manager.add_employees({id_1}, {WORKER_DESCR, WORKER_DESCR}));
+    EXPECT_EQ(manager.find_employee(id_1), std::nullopt);
+
+    EXPECT_TRUE(manager.add_employees({id_1, id_2}, {FOREMAN_DESCR, MANAGER_DESCR}));
+    EXPECT_EQ(manager.find_employee(id_2)->type, MANAGER_DESCR.type);
+}
+
+TEST(main_suite, add_employee_fast_id_generator) {
+    EmployeeManager manager{employee::EmployeeManagerConfig{employee::IdGeneratorType::FAST}};
+
+    const auto [ids, ok] = manager.add_employees(std::vector<EmployeeDescr>(1000, WORKER_DESCR));
+    EXPECT_TRUE(ok);
+
+    std::set<uuid_t> unique_ids(ids.begin(), ids.end());
+    EXPECT_EQ(unique_ids.size(), ids.size());
+
+    for (const uuid_t& id : ids) {
+        EXPECT_EQ(id.version(), uuid_t::version_random_number_based);
+        EXPECT_EQ(id.variant(), uuid_t::variant_rfc_4122);
+    }
+}
+
+TEST(main_suite, add_employee_custom_memory_resource) {
+    //! Memory resource that counts memory taken from it
+    struct CountingResource : std::pmr::memory_resource {
+        size_t allocated = 0;
+        size_t used      = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++allocated;
+            used += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            used -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    } resource;
+
+    {
+        // Every shard of storage has its own columns, so a single one is used to count them
+        employee::EmployeeManagerConfig config{employee::IdGeneratorType::SECURE, &resource};
+        config.storage_shards = 1;
+
+        EmployeeManager manager{config};
+
+        // 1.Columns are taken from the resource once for the whole batch
+        std::vector<uuid_t> ids;
+        bool                ok;
+
+        std::tie(ids, ok) = manager.add_employees(std::vector<EmployeeDescr>(100, WORKER_DESCR));
+        EXPECT_TRUE(ok);
+
+        const size_t allocated = resource.allocated;
+        EXPECT_GT(allocated, 0);
+
+        // 2.Memory of removed employees is reused
+        for (size_t i = 0; i < 10; ++i) {
+            EXPECT_TRUE(manager.remove_employee(ids[i]));
+        }
+        for (size_t i = 0; i < 10; ++i) {
+            ids[i] = manager.add_employee(WORKER_DESCR).first;
+        }
+        auto [chief] = __add_few_employees<1>(manager, MANAGER_DESCR);
+        EXPECT_EQ(resource.allocated, allocated);
+
+        for (const uuid_t& id : ids) {
+            EXPECT_EQ(manager.find_employee(id)->type, EmployeeType::WORKER);
+        }
+        EXPECT_EQ(manager.find_employee(chief)->type, EmployeeType::MANAGER);
+    }
+
+    // 3.All memory is returned with the manager
+    EXPECT_EQ(resource.used, 0);
+}
+
+TEST(main_suite, add_employees) {
+    EmployeeManager manager{};
+
+    // 1.Batch with invalid description: nothing is added
+    EmployeeDescr invalid = WORKER_DESCR;
+    invalid.type          = static_cast<EmployeeType>(42);
+
+    auto [ids, ok] = manager.add_employees({WORKER_DESCR, invalid, MANAGER_DESCR});
+    EXPECT_FALSE(ok);
+    EXPECT_TRUE(ids.empty());
+    EXPECT_TRUE(manager.calculate_total_payroll(MANAGER_DESCR.hire_date).first == 0.0);
+
+    // 2.Valid batch: identifiers are unique and in order of descriptions
+    const std::vector<EmployeeDescr> descriptions{WORKER_DESCR, FOREMAN_DESCR, MANAGER_DESCR};
+
+    std::tie(ids, ok) = manager.add_employees(descriptions);
+    EXPECT_TRUE(ok);
+    ASSERT_EQ(ids.size(), descriptions.size());
+    EXPECT_TRUE(ids[0] != ids[1] && ids[1] != ids[2] && ids[0] != ids[2]);
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const std::optional<EmployeeDescr> found = manager.find_employee(ids[i]);
+        EXPECT_TRUE(found != std::nullopt);
+        EXPECT_EQ(found->type, descriptions[i].type);
+        EXPECT_EQ(found->base_salary, descriptions[i].base_salary);
+    }
+}
+
 TEST(main_suite, remove_employee) {
     EmployeeManager manager{};
 
@@ -68,6 +213,101 @@ TEST(main_suite, remove_employee) {
     EXPECT_TRUE(removed);
 }
 
+TEST(main_suite, remove_employee_keeps_others) {
+    EmployeeManager manager{};
+
+    // 1.Registrate employees with different descriptions
+    std::vector<uuid_t> ids;
+    for (int i = 0; i < 10; ++i) {
+        EmployeeDescr descr = (i % 2 == 0) ? WORKER_DESCR : MANAGER_DESCR;
+        descr.base_salary += i;
+
+        auto [id, ok] = manager.add_employee(descr);
+        EXPECT_TRUE(ok);
+        ids.push_back(id);
+    }
+
+    // 2.Remove the first, the middle and the last ones
+    for (size_t i : {0, 5, 9}) {
+        EXPECT_TRUE(manager.remove_employee(ids[i]));
+    }
+
+    // 3.Others are still found with their own descriptions
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const std::optional<EmployeeDescr> found = manager.find_employee(ids[i]);
+        if (i == 0 || i == 5 || i == 9) {
+            EXPECT_EQ(std::nullopt, found);
+            continue;
+        }
+
+        const EmployeeDescr& expected = (i % 2 == 0) ? WORKER_DESCR : MANAGER_DESCR;
+
+        EXPECT_TRUE(found != std::nullopt);
+        EXPECT_EQ(expected.type, found->type);
+        EXPECT_EQ(expected.base_salary + i, found->base_salary);
+    }
+}
+
+TEST(main_suite, add_remove_employees_concurrently) {
+    EmployeeManager manager{};
+
+    // Chief whose subtree is changed concurrently with registrations
+    auto [chief] = __add_few_employees<1>(manager, MANAGER_DESCR);
+
+    // 1.Every thread registers employees and removes every second of them (some of them with
+    // relation, which takes the slow path)
+    constexpr size_t THREADS_COUNT = 4;
+    constexpr size_t PER_THREAD    = 500;
+
+    std::vector<std::vector<uuid_t>> kept(THREADS_COUNT);
+    std::vector<std::thread>         threads;
+
+    for (size_t t = 0; t < THREADS_COUNT; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < PER_THREAD; ++i) {
+                auto [id, ok] = manager.add_employee(WORKER_DESCR);
+                EXPECT_TRUE(ok);
+
+                if (i % 10 == 0) {
+                    EXPECT_TRUE(manager.add_subordination(chief, id));
+                }
+
+                if (i % 2 == 0) {
+                    EXPECT_TRUE(manager.remove_employee(id));
+                    EXPECT_FALSE(manager.remove_employee(id));
+                    EXPECT_EQ(manager.find_employee(id), std::nullopt);
+                } else {
+                    kept[t].push_back(id);
+                }
+            }
+        });
+    }
+
+    // Calculations run over consistent published registry versions meanwhile
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(manager.calculate_total_payroll(MANAGER_DESCR.hire_date).second);
+        EXPECT_TRUE(manager.calculate_employee_salary(chief, MANAGER_DESCR.hire_date).second);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // 2.Exactly kept employees are registered
+    const auto [payroll, ok] = manager.calculate_payroll_by_type(MANAGER_DESCR.hire_date);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(payroll[EmployeeType::WORKER].headcount, THREADS_COUNT * PER_THREAD / 2);
+
+    for (const std::vector<uuid_t>& ids : kept) {
+        for (const uuid_t& id : ids) {
+            EXPECT_EQ(manager.find_employee(id)->type, EmployeeType::WORKER);
+        }
+    }
+
+    // Removed subordinates are not left in hierarchy
+    EXPECT_EQ(manager.count_all_subordinates(chief), 0);
+}
+
 TEST(main_suite, find_employee) {
     EmployeeManager manager{};
 
@@ -130,6 +370,40 @@ TEST(main_suite, add_subordination) {
     EXPECT_FALSE(manager.add_subordination(wroker_chief, worker_sub));
 }
 
+TEST(main_suite, add_subordinations) {
+    EmployeeManager manager{};
+
+    //      M
+    //     / \
+    //    N   P
+    //   /   / \
+    //  Q   R   S
+    auto [m, n, p, q, r, s] = __add_few_employees<6>(manager, FOREMAN_DESCR);
+    auto [worker]           = __add_few_employees<1>(manager, WORKER_DESCR);
+
+    // 1.Invalid batches: nothing is added
+    const uuid_t some_id = __generate_uuid();
+    EXPECT_FALSE(manager.add_subordinations({{m, n}, {some_id, p}}));
+    EXPECT_FALSE(manager.add_subordinations({{m, n}, {worker, p}}));
+    EXPECT_FALSE(manager.add_subordinations({{m, n}, {p, p}}));
+    EXPECT_FALSE(manager.add_subordinations({{m, n}, {p, n}}));
+    EXPECT_FALSE(manager.add_subordinations({{m, n}, {n, q}, {q, m}}));
+    EXPECT_EQ(manager.get_chief(n), std::nullopt);
+
+    // 2.Valid batch (subordinates are given before their chiefs)
+    EXPECT_TRUE(manager.add_subordinations({{n, q}, {p, r}, {p, s}, {m, n}, {m, p}}));
+
+    for (const uuid_t& id : {m, n, p, q, r, s}) {
+        EXPECT_EQ(manager.count_all_subordinates(id), manager.get_all_subordinates(id).size());
+    }
+    EXPECT_EQ(manager.count_all_subordinates(m), 5);
+    EXPECT_EQ(manager.get_chief(s), p);
+
+    // 3.Cycle through already existing relations
+    EXPECT_FALSE(manager.add_subordinations({{s, worker}, {r, m}}));
+    EXPECT_EQ(manager.get_chief(worker), std::nullopt);
+}
+
 TEST(main_suite, remove_subordination) {
     EmployeeManager manager{};
 
@@ -226,6 +500,55 @@ TEST(main_suite, get_direct_subordinates) {
     EXPECT_TRUE(manager.get_direct_subordinates(chief).size() == 1);
 }
 
+TEST(main_suite, get_direct_subordinates_many) {
+    EmployeeManager manager{};
+
+    auto [chief_a, chief_b] = __add_few_employees<2>(manager, MANAGER_DESCR);
+
+    const auto [ids, ok] = manager.add_employees(std::vector<EmployeeDescr>(3000, WORKER_DESCR));
+    ASSERT_TRUE(ok);
+
+    // 1.Subordinates ranges of both chiefs grow alternately (so they are moved many times)
+    std::set<uuid_t> expected_a, expected_b;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const uuid_t& chief = (i % 2 == 0) ? chief_a : chief_b;
+        EXPECT_TRUE(manager.add_subordination(chief, ids[i]));
+        ((i % 2 == 0) ? expected_a : expected_b).insert(ids[i]);
+    }
+
+    // 2.Move some subordinates and remove some employees
+    for (size_t i = 1; i < ids.size(); i += 4) {
+        EXPECT_TRUE(manager.remove_subordination(chief_b, ids[i]));
+        EXPECT_TRUE(manager.add_subordination(chief_a, ids[i]));
+        expected_b.erase(ids[i]);
+        expected_a.insert(ids[i]);
+    }
+    for (size_t i = 0; i < ids.size(); i += 3) {
+        EXPECT_TRUE(manager.remove_employee(ids[i]));
+        expected_a.erase(ids[i]);
+        expected_b.erase(ids[i]);
+    }
+
+    // 3.Check
+    const std::vector<uuid_t> direct_a = manager.get_direct_subordinates(chief_a);
+    const std::vector<uuid_t> direct_b = manager.get_direct_subordinates(chief_b);
+
+    EXPECT_EQ(std::set<uuid_t>(direct_a.begin(), direct_a.end()), expected_a);
+    EXPECT_EQ(std::set<uuid_t>(direct_b.begin(), direct_b.end()), expected_b);
+    EXPECT_EQ(manager.count_all_subordinates(chief_a), expected_a.size());
+    EXPECT_EQ(manager.get_all_subordinates(chief_b).size(), expected_b.size());
+
+    // 4.Remove chief with all his relations
+    EXPECT_TRUE(manager.remove_employee(chief_b));
+    EXPECT_EQ(manager.get_chief(*expected_b.begin()), std::nullopt);
+
+    EXPECT_TRUE(manager.add_subordination(chief_a, *expected_b.begin()));
+    expected_a.insert(*expected_b.begin());
+
+    const std::vector<uuid_t> direct = manager.get_direct_subordinates(chief_a);
+    EXPECT_EQ(std::set<uuid_t>(direct.begin(), direct.end()), expected_a);
+}
+
 TEST(main_suite, get_all_subordinates) {
     EmployeeManager manager{};
 
@@ -278,6 +601,152 @@ TEST(main_suite, get_all_subordinates) {
     EXPECT_EQ(manager.get_all_subordinates(s).size(), 0);
 }
 
+TEST(main_suite, visit_subordinates) {
+    EmployeeManager manager{};
+
+    // 1.Case non-existen
+    size_t visited = 0;
+    EXPECT_FALSE(manager.visit_all_subordinates(__generate_uuid(), [&](const uuid_t&) {
+        ++visited;
+    }));
+    EXPECT_EQ(visited, 0);
+
+    // 2.Tree case
+    //      M
+    //     / \
+    //    N   P
+    //   /   / \
+    //  Q   R   S
+    auto [m, n, p, q, r, s] = __add_few_employees<6>(manager, FOREMAN_DESCR);
+
+    EXPECT_TRUE(manager.add_subordinations({{m, n}, {m, p}, {n, q}, {p, r}, {p, s}}));
+
+    // 2.1.Visitors: chief is always visited before his subordinates
+    std::vector<uuid_t> all;
+    EXPECT_TRUE(manager.visit_all_subordinates(m, [&all](const uuid_t& id) {
+        all.push_back(id);
+    }));
+    ASSERT_EQ(all.size(), 5);
+
+    const auto position = [&all](const uuid_t& id) {
+        return std::find(all.begin(), all.end(), id) - all.begin();
+    };
+    EXPECT_LT(position(n), position(q));
+    EXPECT_LT(position(p), position(r));
+    EXPECT_LT(position(p), position(s));
+
+    std::vector<uuid_t> direct;
+    EXPECT_TRUE(manager.visit_direct_subordinates(p, [&direct](const uuid_t& id) {
+        direct.push_back(id);
+    }));
+    EXPECT_EQ(std::set<uuid_t>(direct.begin(), direct.end()), std::set<uuid_t>({r, s}));
+
+    EXPECT_TRUE(manager.visit_all_subordinates(q, [&visited](const uuid_t&) { ++visited; }));
+    EXPECT_EQ(visited, 0);
+
+    // 2.2.Output iterators
+    std::set<uuid_t> all_set;
+    manager.get_all_subordinates(m, std::inserter(all_set, all_set.end()));
+    EXPECT_EQ(all_set, std::set<uuid_t>(all.begin(), all.end()));
+
+    std::array<uuid_t, 2> direct_array;
+    EXPECT_EQ(manager.get_direct_subordinates(m, direct_array.begin()), direct_array.end());
+    EXPECT_EQ(std::set<uuid_t>(direct_array.begin(), direct_array.end()),
+              std::set<uuid_t>({n, p}));
+}
+
+TEST(main_suite, is_subordinate) {
+    EmployeeManager manager{};
+
+    // 1.Simple cases
+    auto [m, n, p] = __add_few_employees<3>(manager, FOREMAN_DESCR);
+    EXPECT_TRUE(manager.add_subordination(m, n));
+    EXPECT_TRUE(manager.add_subordination(n, p));
+
+    EXPECT_TRUE(manager.is_subordinate(m, p));
+    EXPECT_FALSE(manager.is_subordinate(p, m));
+    EXPECT_FALSE(manager.is_subordinate(m, m));
+    EXPECT_FALSE(manager.is_subordinate(m, __generate_uuid()));
+
+    EXPECT_TRUE(manager.remove_subordination(m, n));
+    EXPECT_FALSE(manager.is_subordinate(m, p));
+    EXPECT_TRUE(manager.is_subordinate(n, p));
+
+    // 2.Deep chain (runs out of free numbering labels) together with random changes
+    const auto [ids, ok] = manager.add_employees(std::vector<EmployeeDescr>(200, FOREMAN_DESCR));
+    ASSERT_TRUE(ok);
+
+    for (size_t i = 1; i < 100; ++i) {
+        EXPECT_TRUE(manager.add_subordination(ids[i - 1], ids[i]));
+    }
+    EXPECT_TRUE(manager.is_subordinate(ids[0], ids[99]));
+    EXPECT_FALSE(manager.add_subordination(ids[99], ids[0]));
+
+    std::mt19937 random{42};
+    for (int step = 0; step < 300; ++step) {
+        const uuid_t& chief = ids[random() % ids.size()];
+        const uuid_t& sub   = ids[random() % ids.size()];
+
+        if (random() % 3 == 0) {
+            const std::optional<uuid_t> current = manager.get_chief(sub);
+            if (current) {
+                EXPECT_TRUE(manager.remove_subordination(*current, sub));
+            }
+        } else {
+            // Relation is impossible for employee with chief or for chief from his subtree
+            const std::vector<uuid_t> sub_all = manager.get_all_subordinates(sub);
+
+            const bool possible =
+                chief != sub && manager.get_chief(sub) == std::nullopt &&
+                std::find(sub_all.begin(), sub_all.end(), chief) == sub_all.end();
+            EXPECT_EQ(manager.add_subordination(chief, sub), possible);
+        }
+
+        // Check against subordinates lists
+        if (step % 10 == 0 || random() % 2 == 0) {
+            const std::vector<uuid_t> all = manager.get_all_subordinates(chief);
+            EXPECT_EQ(manager.is_subordinate(chief, sub),
+                      std::find(all.begin(), all.end(), sub) != all.end());
+        }
+    }
+}
+
+TEST(main_suite, count_all_subordinates) {
+    EmployeeManager manager{};
+
+    // 1.Case non-existen
+    EXPECT_EQ(manager.count_all_subordinates(__generate_uuid()), 0);
+
+    // 2.Tree case
+    //      M
+    //     / \
+    //    N   P
+    //   /   / \
+    //  Q   R   S
+    auto [m, n, p, q, r, s] = __add_few_employees<6>(manager, FOREMAN_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(n, q));
+    EXPECT_TRUE(manager.add_subordination(p, r));
+    EXPECT_TRUE(manager.add_subordination(p, s));
+
+    EXPECT_TRUE(manager.add_subordination(m, n));
+    EXPECT_TRUE(manager.add_subordination(m, p));
+
+    for (const uuid_t& id : {m, n, p, q, r, s}) {
+        EXPECT_EQ(manager.count_all_subordinates(id), manager.get_all_subordinates(id).size());
+    }
+
+    // 3.Move subtree and remove employee
+    EXPECT_TRUE(manager.remove_subordination(m, p));
+    EXPECT_TRUE(manager.add_subordination(q, p));
+    EXPECT_EQ(manager.count_all_subordinates(m), 5);
+    EXPECT_EQ(manager.count_all_subordinates(n), 4);
+
+    EXPECT_TRUE(manager.remove_employee(p));
+    EXPECT_EQ(manager.count_all_subordinates(m), 2);
+    EXPECT_EQ(manager.count_all_subordinates(q), 0);
+}
+
 TEST(main_suite, calculate_employee_salary_worker) {
     EmployeeManager manager{};
 
@@ -471,6 +940,1201 @@ TEST(main_suite, calculate_employee_salary_manager) {
     EXPECT_NEAR(calculated_salary, expected, 1e-10);
 }
 
+TEST(main_suite, salary_policy) {
+    // 1.Parsing: listed categories are replaced, others keep built-in rules
+    const std::optional<SalaryPolicy> policy = employee::parse_salary_policy(
+        "# tenant rules\n"
+        "worker  0.2 0.5 0.0 0.0\n"
+        "\n"
+        "manager 0.0 0.0 0.02 0.05\n");
+    ASSERT_TRUE(policy.has_value());
+    EXPECT_DOUBLE_EQ((*policy)[EmployeeType::WORKER].seniority_rate, 0.2);
+    EXPECT_DOUBLE_EQ((*policy)[EmployeeType::FOREMAN].direct_bonus_rate,
+                     employee::DEFAULT_SALARY_POLICY[EmployeeType::FOREMAN].direct_bonus_rate);
+
+    EXPECT_FALSE(employee::parse_salary_policy("intern 0.1 0.2 0.0 0.0").has_value());
+    EXPECT_FALSE(employee::parse_salary_policy("worker 0.1 0.2 0.0").has_value());
+    EXPECT_FALSE(employee::parse_salary_policy("worker 0.1 0.2 0.0 0.0 1.0").has_value());
+    EXPECT_FALSE(employee::parse_salary_policy("worker -0.1 0.2 0.0 0.0").has_value());
+
+    // 2.manager -> foreman -> worker with runtime policy (foreman keeps built-in rules)
+    employee::EmployeeManagerConfig config;
+    config.salary_policy = policy;
+
+    EmployeeManager manager{config};
+
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+    auto [worker_id]  = __add_few_employees<1>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_id));
+
+    const date_t calc_date = MANAGER_DESCR.hire_date + bg::years(3);
+
+    const double worker_salary  = 1.5 * WORKER_DESCR.base_salary;
+    const double foreman_salary = 1.15 * FOREMAN_DESCR.base_salary + 0.07 * worker_salary;
+    const double manager_salary = MANAGER_DESCR.base_salary + 0.02 * foreman_salary +
+                                  0.05 * (foreman_salary + worker_salary);
+
+    EXPECT_NEAR(manager.calculate_employee_salary(worker_id, calc_date).first, worker_salary,
+                1e-8);
+    EXPECT_NEAR(manager.calculate_employee_salary(foreman_id, calc_date).first, foreman_salary,
+                1e-8);
+    EXPECT_NEAR(manager.calculate_employee_salary(manager_id, calc_date).first, manager_salary,
+                1e-8);
+    EXPECT_NEAR(manager.calculate_total_payroll(calc_date).first,
+                worker_salary + foreman_salary + manager_salary, 1e-8);
+
+    const PayrollByType by_type = manager.calculate_payroll_by_type(calc_date).first;
+    EXPECT_NEAR(by_type[EmployeeType::MANAGER].total, manager_salary, 1e-8);
+
+    // 3.Series (calculated by weights of salaries) agree with month by month calculation
+    const date_t from = MANAGER_DESCR.hire_date - bg::months(2);
+    const date_t to   = calc_date + bg::years(2);
+
+    const auto series         = manager.calculate_salary_series(manager_id, from, to);
+    const auto payroll_series = manager.calculate_payroll_series(from, to);
+
+    date_t date = from;
+    for (size_t i = 0; i < series.size(); ++i, date += bg::months(1)) {
+        const auto [salary, ok] = manager.calculate_employee_salary(manager_id, date);
+        EXPECT_EQ(series[i].second, ok);
+        EXPECT_NEAR(series[i].first, salary, 1e-6);
+
+        const auto [total, total_ok] = manager.calculate_total_payroll(date);
+        EXPECT_EQ(payroll_series[i].second, total_ok);
+        EXPECT_NEAR(payroll_series[i].first, total, 1e-6);
+    }
+
+    // 4.Registry view calculates by the same policy
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "employee_lib_salary_policy.bin").string();
+    ASSERT_TRUE(manager.save(path));
+
+    EmployeeRegistryView view{*policy};
+    ASSERT_TRUE(view.open(path));
+    EXPECT_NEAR(view.calculate_total_payroll(calc_date).first,
+                worker_salary + foreman_salary + manager_salary, 1e-8);
+
+    std::filesystem::remove(path);
+
+    // 5.Runtime table of built-in rules gives the same salaries as compile-time ones
+    config.salary_policy = employee::DEFAULT_SALARY_POLICY;
+
+    EmployeeManager builtin{};
+    EmployeeManager table{config};
+
+    for (EmployeeManager* m : {&builtin, &table}) {
+        std::vector<uuid_t> chiefs;
+        for (int i = 0; i < 100; ++i) {
+            const EmployeeType type = (i % 20 == 0)  ? EmployeeType::MANAGER
+                                      : (i % 5 == 0) ? EmployeeType::FOREMAN
+                                                     : EmployeeType::WORKER;
+            const uuid_t id = __generate_uuid();
+            EXPECT_TRUE(m->add_employee(
+                id, {type, 1000.0 + i, MANAGER_DESCR.hire_date + bg::months(i % 37)}));
+
+            if (!chiefs.empty()) {
+                EXPECT_TRUE(m->add_subordination(chiefs[(i * 7) % chiefs.size()], id));
+            }
+            if (type != EmployeeType::WORKER) {
+                chiefs.push_back(id);
+            }
+        }
+    }
+
+    const date_t later = MANAGER_DESCR.hire_date + bg::years(5);
+    EXPECT_NEAR(builtin.calculate_total_payroll(later).first,
+                table.calculate_total_payroll(later).first, 1e-6);
+}
+
+TEST(main_suite, calculate_total_payroll) {
+    EmployeeManager manager{};
+
+    // 1.Empty registry
+    auto [total, ok] = manager.calculate_total_payroll(MANAGER_DESCR.hire_date);
+    EXPECT_TRUE(ok);
+    EXPECT_NEAR(total, 0.0, 1e-10);
+
+    // 2.Hierarchy: manager -> (foreman -> (worker, worker), worker) and standalone worker
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+
+    auto [worker_1, worker_2, worker_3, worker_4] = __add_few_employees<4>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(manager_id, worker_1));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_2));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_3));
+
+    // 3.Total payroll must be equal to sum of each employee salary
+    date_t calc_date = MANAGER_DESCR.hire_date;
+    for (int year = 0; year < 12; ++year, calc_date += bg::years(1)) {
+        double expected = 0.0;
+        for (const uuid_t& id : {manager_id, foreman_id, worker_1, worker_2, worker_3, worker_4}) {
+            auto [salary, salary_ok] = manager.calculate_employee_salary(id, calc_date);
+            EXPECT_TRUE(salary_ok);
+            expected += salary;
+        }
+
+        std::tie(total, ok) = manager.calculate_total_payroll(calc_date);
+        EXPECT_TRUE(ok);
+        EXPECT_NEAR(total, expected, 1e-6);
+    }
+
+    // 4.Calculation date less then hire
+    std::tie(total, ok) = manager.calculate_total_payroll(date_t{2024, 1, 1});
+    EXPECT_FALSE(ok);
+}
+
+TEST(main_suite, calculate_total_payroll_for_dates) {
+    EmployeeManager manager{};
+
+    // 1.Hierarchy with different hire dates (count of employees is not a multiple of vector width)
+    std::vector<uuid_t> ids, chiefs;
+    for (int i = 0; i < 23; ++i) {
+        const EmployeeType type = (i % 11 == 0) ? EmployeeType::MANAGER
+                                  : (i % 4 == 0) ? EmployeeType::FOREMAN
+                                                 : EmployeeType::WORKER;
+
+        const date_t hire_date = MANAGER_DESCR.hire_date + bg::months(5 * i);
+
+        auto [id, ok] = manager.add_employee({type, 1000.0 + 10.0 * i, hire_date});
+        ASSERT_TRUE(ok);
+        ids.push_back(id);
+
+        if (!chiefs.empty()) {
+            EXPECT_TRUE(manager.add_subordination(chiefs.back(), id));
+        }
+        if (type != EmployeeType::WORKER) {
+            chiefs.push_back(id);
+        }
+    }
+
+    // 2.Dates before, during and after hires
+    std::vector<date_t> dates;
+    for (date_t date = MANAGER_DESCR.hire_date - bg::years(1);
+         date < MANAGER_DESCR.hire_date + bg::years(25); date += bg::months(7)) {
+        dates.push_back(date);
+    }
+
+    // 3.Batch result must be equal to sum of each employee salary for every date
+    const auto totals = manager.calculate_total_payroll(dates);
+    ASSERT_EQ(totals.size(), dates.size());
+
+    for (size_t i = 0; i < dates.size(); ++i) {
+        double expected    = 0.0;
+        bool   expected_ok = true;
+        for (const uuid_t& id : ids) {
+            const auto [salary, salary_ok] = manager.calculate_employee_salary(id, dates[i]);
+            expected += salary;
+            expected_ok &= salary_ok;
+        }
+
+        EXPECT_EQ(totals[i].second, expected_ok);
+        if (expected_ok) {
+            EXPECT_NEAR(totals[i].first, expected, 1e-6);
+        }
+    }
+    EXPECT_FALSE(totals.front().second);
+    EXPECT_TRUE(totals.back().second);
+}
+
+TEST(main_suite, calculate_payroll_by_type) {
+    EmployeeManager manager{};
+
+    // 1.Empty registry
+    auto [payroll, ok] = manager.calculate_payroll_by_type(MANAGER_DESCR.hire_date);
+    EXPECT_TRUE(ok);
+    for (const CategoryPayroll& category : payroll.categories) {
+        EXPECT_EQ(category.headcount, 0u);
+        EXPECT_NEAR(category.total, 0.0, 1e-10);
+    }
+
+    // 2.Hierarchy: manager -> (foreman -> (worker, worker), worker) and standalone worker
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+
+    auto [worker_1, worker_2, worker_3, worker_4] = __add_few_employees<4>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(manager_id, worker_1));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_2));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_3));
+
+    // 3.Category totals must be equal to sums of salaries of category employees
+    const std::vector<std::pair<uuid_t, EmployeeType>> employees = {
+        {manager_id, EmployeeType::MANAGER}, {foreman_id, EmployeeType::FOREMAN},
+        {worker_1, EmployeeType::WORKER},    {worker_2, EmployeeType::WORKER},
+        {worker_3, EmployeeType::WORKER},    {worker_4, EmployeeType::WORKER}};
+
+    date_t calc_date = MANAGER_DESCR.hire_date;
+    for (int year = 0; year < 12; ++year, calc_date += bg::years(1)) {
+        PayrollByType expected;
+        for (const auto& [id, type] : employees) {
+            auto [salary, salary_ok] = manager.calculate_employee_salary(id, calc_date);
+            EXPECT_TRUE(salary_ok);
+            expected[type].total += salary;
+            ++expected[type].headcount;
+        }
+
+        std::tie(payroll, ok) = manager.calculate_payroll_by_type(calc_date);
+        EXPECT_TRUE(ok);
+        for (EmployeeType type :
+             {EmployeeType::WORKER, EmployeeType::FOREMAN, EmployeeType::MANAGER}) {
+            EXPECT_EQ(payroll[type].headcount, expected[type].headcount);
+            EXPECT_NEAR(payroll[type].total, expected[type].total, 1e-6);
+        }
+
+        const double total = payroll[EmployeeType::WORKER].total +
+                             payroll[EmployeeType::FOREMAN].total +
+                             payroll[EmployeeType::MANAGER].total;
+        EXPECT_NEAR(total, manager.calculate_total_payroll(calc_date).first, 1e-6);
+    }
+
+    // 4.Calculation date less then hire (headcounts are still known)
+    std::tie(payroll, ok) = manager.calculate_payroll_by_type(date_t{2024, 1, 1});
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(payroll[EmployeeType::WORKER].headcount, 4u);
+    EXPECT_NEAR(payroll[EmployeeType::WORKER].total, 0.0, 1e-10);
+}
+
+TEST(main_suite, calculate_salary_series) {
+    EmployeeManager manager{};
+
+    // 1.Hierarchy of all categories with different hire dates
+    std::vector<uuid_t> ids, chiefs;
+    for (int i = 0; i < 23; ++i) {
+        const EmployeeType type = (i % 7 == 0) ? EmployeeType::MANAGER
+                                  : (i % 3 == 0) ? EmployeeType::FOREMAN
+                                                 : EmployeeType::WORKER;
+
+        const date_t hire_date = MANAGER_DESCR.hire_date + bg::months(4 * i);
+
+        auto [id, ok] = manager.add_employee({type, 1000.0 + 10.0 * i, hire_date});
+        ASSERT_TRUE(ok);
+        ids.push_back(id);
+
+        if (!chiefs.empty()) {
+            EXPECT_TRUE(manager.add_subordination(chiefs[(i * 5) % chiefs.size()], id));
+        }
+        if (type != EmployeeType::WORKER) {
+            chiefs.push_back(id);
+        }
+    }
+
+    // 2.Months before, during and after hires, up to the bonus caps (day values are ignored)
+    const date_t from = MANAGER_DESCR.hire_date - bg::months(3) + bg::days(10);
+    const date_t to   = MANAGER_DESCR.hire_date + bg::years(25);
+
+    std::vector<date_t> dates;
+    for (date_t date = MANAGER_DESCR.hire_date - bg::months(3); date <= to;
+         date += bg::months(1)) {
+        dates.push_back(date);
+    }
+
+    // 3.Series must be equal to salary calculated for every month
+    for (const uuid_t& id : ids) {
+        const auto series = manager.calculate_salary_series(id, from, to);
+        ASSERT_EQ(series.size(), dates.size());
+
+        for (size_t i = 0; i < dates.size(); ++i) {
+            const auto [salary, ok] = manager.calculate_employee_salary(id, dates[i]);
+            EXPECT_EQ(series[i].second, ok);
+            EXPECT_NEAR(series[i].first, salary, 1e-6);
+        }
+    }
+
+    const auto payroll_series = manager.calculate_payroll_series(from, to);
+    const auto totals         = manager.calculate_total_payroll(dates);
+    ASSERT_EQ(payroll_series.size(), totals.size());
+
+    for (size_t i = 0; i < totals.size(); ++i) {
+        EXPECT_EQ(payroll_series[i].second, totals[i].second);
+        EXPECT_NEAR(payroll_series[i].first, totals[i].first, 1e-6);
+    }
+    EXPECT_FALSE(payroll_series.front().second);
+    EXPECT_TRUE(payroll_series.back().second);
+
+    // 4.Empty range and unregistered employee
+    EXPECT_TRUE(manager.calculate_salary_series(ids.front(), to, from).empty());
+    EXPECT_TRUE(manager.calculate_payroll_series(to, from).empty());
+
+    const auto unknown = manager.calculate_salary_series(uuid_t{}, from, to);
+    ASSERT_EQ(unknown.size(), dates.size());
+    for (const auto& [salary, ok] : unknown) {
+        EXPECT_FALSE(ok);
+    }
+}
+
+TEST(main_suite, calculate_salary_by_month_ordinal) {
+    EmployeeManager manager{};
+
+    // 1.Month ordinal ignores day value
+    const date_t hire_date{2026, 3, 17};
+    EXPECT_EQ(employee::to_month(hire_date), 12 * 2026 + 2);
+    EXPECT_EQ(employee::to_date(employee::to_month(hire_date)), date_t(2026, 3, 1));
+
+    // 2.Salaries are calculated by hire month, but the exact hire date is found
+    const EmployeeDescr manager_descr{EmployeeType::MANAGER, 1000.0, hire_date};
+
+    auto [manager_id] = __add_few_employees<1>(manager, manager_descr);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+    auto [worker_id]  = __add_few_employees<1>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_id));
+
+    EXPECT_EQ(manager.find_employee(manager_id)->hire_date, hire_date);
+
+    // 3.Overloads by month ordinal are equal to overloads by date
+    std::vector<date_t>            dates;
+    std::vector<employee::month_t> months;
+    for (date_t date = hire_date - bg::years(1); date < hire_date + bg::years(12);
+         date += bg::months(5)) {
+        dates.push_back(date);
+        months.push_back(employee::to_month(date));
+
+        for (const uuid_t& id : {manager_id, foreman_id, worker_id}) {
+            EXPECT_EQ(manager.calculate_employee_salary(id, months.back()),
+                      manager.calculate_employee_salary(id, date));
+        }
+        EXPECT_EQ(manager.calculate_total_payroll(months.back()),
+                  manager.calculate_total_payroll(date));
+        EXPECT_EQ(manager.calculate_payroll_by_type(months.back()).second,
+                  manager.calculate_payroll_by_type(date).second);
+    }
+    EXPECT_EQ(manager.calculate_total_payroll(months), manager.calculate_total_payroll(dates));
+
+    EXPECT_EQ(manager.calculate_salary_series(manager_id, months.front(), months.back()),
+              manager.calculate_salary_series(manager_id, dates.front(), dates.back()));
+    EXPECT_EQ(manager.calculate_payroll_series(months.front(), months.back()),
+              manager.calculate_payroll_series(dates.front(), dates.back()));
+}
+
+TEST(main_suite, calculate_employee_salary_memo_months) {
+    EmployeeManager manager{};
+
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+    auto [worker_id]  = __add_few_employees<1>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_id));
+
+    const employee::month_t first = employee::to_month(WORKER_DESCR.hire_date);
+    const employee::month_t last  = first + 40;
+
+    // 1.More months than memoized for employee: replaced months are calculated again
+    const auto check_months = [&](const uuid_t& id) {
+        const std::vector<std::pair<double, bool>> series =
+            manager.calculate_salary_series(id, first, last);
+
+        for (size_t pass = 0; pass < 2; ++pass) {
+            for (employee::month_t month = first; month <= last; ++month) {
+                EXPECT_EQ(manager.calculate_employee_salary(id, month), series[month - first]);
+            }
+        }
+    };
+    check_months(manager_id);
+    check_months(worker_id);
+
+    // 2.Employee registered again with the same identifier is not calculated by memoized
+    // salaries of removed one (removed by both lock paths)
+    const EmployeeDescr worker_descr{EmployeeType::WORKER, 2 * WORKER_DESCR.base_salary,
+                                     WORKER_DESCR.hire_date};
+
+    EXPECT_TRUE(manager.remove_employee(worker_id));
+    EXPECT_TRUE(manager.add_employee(worker_id, worker_descr));
+    check_months(worker_id);
+
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_id));
+    check_months(manager_id);
+
+    EXPECT_TRUE(manager.remove_subordination(foreman_id, worker_id));
+    EXPECT_TRUE(manager.remove_employee(worker_id));
+    EXPECT_TRUE(manager.add_employee(worker_id, WORKER_DESCR));
+    EXPECT_EQ(manager.calculate_employee_salary(worker_id, last),
+              manager.calculate_salary_series(worker_id, last, last).front());
+}
+
+TEST(main_suite, calculate_salary_parallel) {
+    //! Registry with large hierarchy: top manager -> 8 managers -> 8 foremen each -> workers
+    const auto build = [](EmployeeManager& manager) {
+        std::vector<EmployeeDescr> descriptions;
+        for (size_t i = 0; i < 20000; ++i) {
+            const EmployeeType type = (i <= 8)           ? EmployeeType::MANAGER
+                                      : (i <= 8 + 8 * 8) ? EmployeeType::FOREMAN
+                                                         : EmployeeType::WORKER;
+            const date_t hire_date = MANAGER_DESCR.hire_date + bg::months(i % 37);
+
+            descriptions.push_back({type, 1000.0 + 0.5 * i, hire_date});
+        }
+
+        std::vector<uuid_t> ids(descriptions.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            ids[i] = boost::uuids::name_generator_sha1(boost::uuids::ns::oid())(std::to_string(i));
+        }
+        EXPECT_TRUE(manager.add_employees(ids, descriptions));
+
+        std::vector<std::pair<uuid_t, uuid_t>> relations;
+        for (size_t i = 1; i < ids.size(); ++i) {
+            const size_t chief = (i <= 8) ? 0 : (i <= 8 + 8 * 8) ? 1 + (i - 9) / 8 : 9 + i % 64;
+            relations.emplace_back(ids[chief], ids[i]);
+        }
+        EXPECT_TRUE(manager.add_subordinations(relations));
+
+        return ids.front();
+    };
+
+    EmployeeManager sequential{};
+    EmployeeManager parallel_2{employee::EmployeeManagerConfig{{}, nullptr, 2}};
+    EmployeeManager parallel_4{employee::EmployeeManagerConfig{{}, nullptr, 4}};
+
+    const uuid_t top = build(sequential);
+    build(parallel_2);
+    build(parallel_4);
+
+    // Results of parallel calculations must not depend on number of threads
+    for (const date_t& date : {MANAGER_DESCR.hire_date, MANAGER_DESCR.hire_date + bg::years(5)}) {
+        const auto [salary, ok]      = sequential.calculate_employee_salary(top, date);
+        const auto [total, total_ok] = sequential.calculate_total_payroll(date);
+
+        EXPECT_EQ(parallel_2.calculate_employee_salary(top, date),
+                  parallel_4.calculate_employee_salary(top, date));
+        EXPECT_EQ(parallel_2.calculate_total_payroll(date),
+                  parallel_4.calculate_total_payroll(date));
+
+        const auto [parallel_salary, parallel_ok] = parallel_4.calculate_employee_salary(top, date);
+        const auto [parallel_total, parallel_total_ok] = parallel_4.calculate_total_payroll(date);
+
+        EXPECT_EQ(ok, parallel_ok);
+        EXPECT_EQ(total_ok, parallel_total_ok);
+        EXPECT_NEAR(salary, parallel_salary, 1e-9 * salary);
+        EXPECT_NEAR(total, parallel_total, 1e-9 * total);
+    }
+
+    // Loops submitted by many non-worker threads at once are all completed
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 6; ++t) {
+        submitters.emplace_back([&, t]() {
+            for (int k = 0; k < 4; ++k) {
+                const date_t date = MANAGER_DESCR.hire_date + bg::months(7 * t + k);
+
+                const auto [total, ok]                   = sequential.calculate_total_payroll(date);
+                const auto [parallel_total, parallel_ok] = parallel_2.calculate_total_payroll(date);
+
+                EXPECT_EQ(ok, parallel_ok);
+                EXPECT_NEAR(total, parallel_total, 1e-9 * total);
+            }
+        });
+    }
+    for (std::thread& submitter : submitters) {
+        submitter.join();
+    }
+}
+
+TEST(main_suite, calculate_employee_salary_async) {
+    employee::EmployeeManagerConfig config;
+    config.async_threads = 1;
+
+    EmployeeManager manager{config};
+
+    // manager -> foreman -> 2 workers
+    auto [manager_id]         = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id]         = __add_few_employees<1>(manager, FOREMAN_DESCR);
+    auto [worker_1, worker_2] = __add_few_employees<2>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_1));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_2));
+
+    const date_t calc_date = MANAGER_DESCR.hire_date;
+
+    const double foreman_salary = FOREMAN_DESCR.base_salary + 0.07 * 2 * WORKER_DESCR.base_salary;
+    const double manager_salary =
+        MANAGER_DESCR.base_salary + 0.03 * (foreman_salary + 2 * WORKER_DESCR.base_salary);
+
+    // 1.Single thread of executor is held by callback, so following requests are pending
+    std::promise<void>       release;
+    std::shared_future<void> released = release.get_future().share();
+
+    std::promise<std::pair<double, bool>> worker_result;
+    manager.calculate_employee_salary_async(
+        worker_1, calc_date,
+        [&released, &worker_result](const std::pair<double, bool>& result) {
+            worker_result.set_value(result);
+            released.wait();
+        });
+
+    // 2.Concurrent requests of the same employee and month are coalesced
+    const employee::month_t calc_month = employee::to_month(calc_date);
+
+    auto first  = manager.calculate_employee_salary_async(manager_id, calc_date);
+    auto second = manager.calculate_employee_salary_async(manager_id, calc_month);
+
+    const std::vector<uuid_t> batch_ids{worker_2, foreman_id, __generate_uuid(), manager_id};
+    auto batch = manager.calculate_employee_salaries_async(batch_ids, calc_date);
+
+    release.set_value();
+
+    EXPECT_EQ(&first.get(), &second.get());
+    EXPECT_TRUE(first.get().second);
+    EXPECT_NEAR(first.get().first, manager_salary, 1e-10);
+
+    const auto [worker_salary, worker_ok] = worker_result.get_future().get();
+    EXPECT_TRUE(worker_ok);
+    EXPECT_NEAR(worker_salary, WORKER_DESCR.base_salary, 1e-10);
+
+    // 3.Batch results are in order of identifiers (unknown employee is not calculated)
+    const std::vector<std::pair<double, bool>> salaries = batch.get();
+    ASSERT_EQ(salaries.size(), 4);
+    EXPECT_NEAR(salaries[0].first, WORKER_DESCR.base_salary, 1e-10);
+    EXPECT_NEAR(salaries[1].first, foreman_salary, 1e-10);
+    EXPECT_FALSE(salaries[2].second);
+    EXPECT_NEAR(salaries[3].first, manager_salary, 1e-10);
+
+    // 4.Request after change is not coalesced with older ones
+    EXPECT_TRUE(manager.remove_subordination(foreman_id, worker_2));
+
+    const double new_foreman_salary = FOREMAN_DESCR.base_salary + 0.07 * WORKER_DESCR.base_salary;
+    auto [salary, ok] = manager.calculate_employee_salary_async(foreman_id, calc_date).get();
+    EXPECT_TRUE(ok);
+    EXPECT_NEAR(salary, new_foreman_salary, 1e-10);
+
+    auto empty_batch = manager.calculate_employee_salaries_async(std::vector<uuid_t>{}, calc_date);
+    EXPECT_TRUE(empty_batch.get().empty());
+}
+
+TEST(main_suite, calculate_employee_salary_after_hierarchy_change) {
+    EmployeeManager manager{};
+
+    // manager -> foreman -> worker
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+    auto [worker_1]   = __add_few_employees<1>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_1));
+
+    const date_t calc_date = MANAGER_DESCR.hire_date;
+
+    auto salary_of = [&manager, &calc_date](const uuid_t& id) {
+        auto [salary, ok] = manager.calculate_employee_salary(id, calc_date);
+        EXPECT_TRUE(ok);
+        return salary;
+    };
+
+    const double foreman_salary = FOREMAN_DESCR.base_salary + 0.07 * WORKER_DESCR.base_salary;
+    double expected =
+        MANAGER_DESCR.base_salary + 0.03 * (foreman_salary + WORKER_DESCR.base_salary);
+
+    EXPECT_NEAR(salary_of(manager_id), expected, 1e-10);
+
+    // 1.Add indirect subordinate: salaries of the whole chiefs chain must be recalculated
+    auto [worker_2] = __add_few_employees<1>(manager, WORKER_DESCR);
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_2));
+
+    const double new_foreman_salary =
+        FOREMAN_DESCR.base_salary + 0.07 * 2 * WORKER_DESCR.base_salary;
+    expected =
+        MANAGER_DESCR.base_salary + 0.03 * (new_foreman_salary + 2 * WORKER_DESCR.base_salary);
+
+    EXPECT_NEAR(salary_of(foreman_id), new_foreman_salary, 1e-10);
+    EXPECT_NEAR(salary_of(manager_id), expected, 1e-10);
+
+    // 2.Remove subordination
+    EXPECT_TRUE(manager.remove_subordination(foreman_id, worker_2));
+    expected = MANAGER_DESCR.base_salary + 0.03 * (foreman_salary + WORKER_DESCR.base_salary);
+
+    EXPECT_NEAR(salary_of(manager_id), expected, 1e-10);
+
+    // 3.Remove employee: his relations are removed too
+    EXPECT_TRUE(manager.remove_employee(worker_1));
+    expected = MANAGER_DESCR.base_salary + 0.03 * FOREMAN_DESCR.base_salary;
+
+    EXPECT_NEAR(salary_of(manager_id), expected, 1e-10);
+    EXPECT_TRUE(manager.get_direct_subordinates(foreman_id).empty());
+}
+
+TEST(main_suite, calculate_employee_salary_mixed_with_changes) {
+    EmployeeManager manager{};
+
+    // manager -> 3 foremen -> 30 workers
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+
+    std::vector<uuid_t> foremen;
+    std::vector<uuid_t> workers;
+    for (size_t i = 0; i < 3; ++i) {
+        foremen.push_back(std::get<0>(__add_few_employees<1>(manager, FOREMAN_DESCR)));
+        EXPECT_TRUE(manager.add_subordination(manager_id, foremen.back()));
+    }
+    for (size_t i = 0; i < 30; ++i) {
+        const EmployeeDescr descr{EmployeeType::WORKER, WORKER_DESCR.base_salary + i,
+                                  WORKER_DESCR.hire_date + bg::months(i)};
+
+        workers.push_back(manager.add_employee(descr).first);
+        EXPECT_TRUE(manager.add_subordination(foremen[i % 3], workers.back()));
+    }
+
+    std::vector<uuid_t> department = {manager_id};
+    department.insert(department.end(), foremen.begin(), foremen.end());
+    department.insert(department.end(), workers.begin(), workers.end());
+
+    const employee::month_t month = employee::to_month(WORKER_DESCR.hire_date) + 40;
+
+    // Every change is followed by queries (data are newer than the last snapshot), then results
+    // are checked by calculation over new snapshot
+    const auto check_department = [&]() {
+        std::vector<std::pair<double, bool>> salaries;
+        for (const uuid_t& id : department) {
+            salaries.push_back(manager.calculate_employee_salary(id, month));
+        }
+        const std::vector<std::pair<double, bool>> batch =
+            manager.calculate_employee_salaries_async(department, month).get();
+
+        for (size_t i = 0; i < department.size(); ++i) {
+            const auto [expected, ok] =
+                manager.calculate_salary_series(department[i], month, month).front();
+
+            EXPECT_TRUE(ok);
+            EXPECT_TRUE(salaries[i].second);
+            EXPECT_TRUE(batch[i].second);
+            EXPECT_NEAR(salaries[i].first, expected, 1e-9 * expected);
+            EXPECT_NEAR(batch[i].first, expected, 1e-9 * expected);
+        }
+    };
+    check_department();
+
+    for (size_t round = 0; round < 30; ++round) {
+        // 1.Employee without relations: registered and removed under shared lock
+        const uuid_t id = manager.add_employee(WORKER_DESCR).first;
+        EXPECT_TRUE(manager.calculate_employee_salary(id, month).second);
+        check_department();
+
+        EXPECT_TRUE(manager.remove_employee(id));
+        EXPECT_FALSE(manager.calculate_employee_salary(id, month).second);
+        check_department();
+
+        // 2.Worker is moved to the next foreman
+        const uuid_t& worker = workers[round];
+        const uuid_t  chief  = *manager.get_chief(worker);
+        const size_t  next   = (std::find(foremen.begin(), foremen.end(), chief) -
+                             foremen.begin() + 1) % foremen.size();
+
+        EXPECT_TRUE(manager.remove_subordination(chief, worker));
+        EXPECT_TRUE(manager.add_subordination(foremen[next], worker));
+        check_department();
+    }
+
+    // 3.Foreman with subordinates is removed, then they are moved to another foreman at once
+    const uuid_t              removed = foremen.back();
+    const std::vector<uuid_t> orphans = manager.get_direct_subordinates(removed);
+
+    EXPECT_TRUE(manager.remove_employee(removed));
+    department.erase(std::find(department.begin(), department.end(), removed));
+    check_department();
+
+    std::vector<std::pair<uuid_t, uuid_t>> relations;
+    for (const uuid_t& orphan : orphans) {
+        relations.emplace_back(foremen.front(), orphan);
+    }
+    EXPECT_TRUE(manager.add_subordinations(relations));
+    check_department();
+}
+
+TEST(main_suite, calculate_total_payroll_under_concurrent_changes) {
+    EmployeeManager manager{};
+
+    // manager -> (foreman, worker_1); worker_2 is moved between manager and foreman concurrently
+    auto [manager_id] = __add_few_employees<1>(manager, MANAGER_DESCR);
+    auto [foreman_id] = __add_few_employees<1>(manager, FOREMAN_DESCR);
+
+    auto [worker_1, worker_2] = __add_few_employees<2>(manager, WORKER_DESCR);
+
+    EXPECT_TRUE(manager.add_subordination(manager_id, foreman_id));
+    EXPECT_TRUE(manager.add_subordination(manager_id, worker_1));
+
+    const date_t calc_date = MANAGER_DESCR.hire_date;
+
+    // 1.Totals of both consistent states
+    EXPECT_TRUE(manager.add_subordination(manager_id, worker_2));
+    const double total_under_manager = manager.calculate_total_payroll(calc_date).first;
+
+    EXPECT_TRUE(manager.remove_subordination(manager_id, worker_2));
+    EXPECT_TRUE(manager.add_subordination(foreman_id, worker_2));
+    const double total_under_foreman = manager.calculate_total_payroll(calc_date).first;
+
+    // 2.Every calculation must see one of them, never a half-done move
+    std::atomic<bool> stop{false};
+    std::thread       writer([&]() {
+        for (int i = 0; i < 200; ++i) {
+            EXPECT_TRUE(manager.remove_subordination(foreman_id, worker_2));
+            EXPECT_TRUE(manager.add_subordination(manager_id, worker_2));
+            EXPECT_TRUE(manager.remove_subordination(manager_id, worker_2));
+            EXPECT_TRUE(manager.add_subordination(foreman_id, worker_2));
+        }
+        stop = true;
+    });
+
+    while (!stop) {
+        auto [total, ok] = manager.calculate_total_payroll(calc_date);
+        EXPECT_TRUE(ok);
+
+        // Worker without chief is a valid state too
+        const double total_without_chief =
+            MANAGER_DESCR.base_salary + FOREMAN_DESCR.base_salary + 2 * WORKER_DESCR.base_salary +
+            0.03 * (FOREMAN_DESCR.base_salary + WORKER_DESCR.base_salary);
+
+        EXPECT_TRUE(std::abs(total - total_under_manager) < 1e-6 ||
+                    std::abs(total - total_under_foreman) < 1e-6 ||
+                    std::abs(total - total_without_chief) < 1e-6);
+    }
+
+    writer.join();
+}
+
+TEST(main_suite, save_load) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "employee_lib_save_load.bin").string();
+
+    // 1.Registry with hierarchy forest of all categories and different hire dates
+    EmployeeManager source{};
+
+    std::vector<uuid_t> ids, chiefs;
+    for (int i = 0; i < 200; ++i) {
+        const EmployeeType type = (i % 20 == 0)  ? EmployeeType::MANAGER
+                                  : (i % 5 == 0) ? EmployeeType::FOREMAN
+                                                 : EmployeeType::WORKER;
+
+        auto [id, ok] = source.add_employee(
+            {type, 1000.0 + 1.5 * i,
+             MANAGER_DESCR.hire_date + bg::months(i % 37) + bg::days(i % 28)});
+        ASSERT_TRUE(ok);
+        ids.push_back(id);
+
+        if (!chiefs.empty() && i % 50 != 0) {
+            EXPECT_TRUE(source.add_subordination(chiefs[(i * 7) % chiefs.size()], id));
+        }
+        if (type != EmployeeType::WORKER) {
+            chiefs.push_back(id);
+        }
+    }
+    EXPECT_TRUE(source.remove_employee(ids[3]));
+
+    ASSERT_TRUE(source.save(path));
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    // 2.Loaded registry has the same employees, hierarchy and salaries
+    EmployeeManager target{};
+    ASSERT_TRUE(target.load(path));
+
+    const date_t calc_date = MANAGER_DESCR.hire_date + bg::years(5);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        EXPECT_EQ(target.find_employee(ids[i]).has_value(), i != 3);
+        if (i == 3) {
+            continue;
+        }
+
+        EXPECT_EQ(target.find_employee(ids[i])->type, source.find_employee(ids[i])->type);
+        EXPECT_EQ(target.find_employee(ids[i])->base_salary,
+                  source.find_employee(ids[i])->base_salary);
+        EXPECT_EQ(target.find_employee(ids[i])->hire_date,
+                  MANAGER_DESCR.hire_date + bg::months(i % 37) + bg::days(i % 28));
+        EXPECT_EQ(target.get_chief(ids[i]), source.get_chief(ids[i]));
+
+        std::vector<uuid_t> target_subordinates = target.get_direct_subordinates(ids[i]);
+        std::vector<uuid_t> source_subordinates = source.get_direct_subordinates(ids[i]);
+        std::sort(target_subordinates.begin(), target_subordinates.end());
+        std::sort(source_subordinates.begin(), source_subordinates.end());
+        EXPECT_EQ(target_subordinates, source_subordinates);
+
+        EXPECT_EQ(target.calculate_employee_salary(ids[i], calc_date),
+                  source.calculate_employee_salary(ids[i], calc_date));
+    }
+    EXPECT_EQ(target.calculate_total_payroll(calc_date), source.calculate_total_payroll(calc_date));
+
+    // 3.Registry must be empty to load
+    EXPECT_FALSE(target.load(path));
+
+    // 4.Missing, truncated and corrupted files are rejected
+    EmployeeManager empty{};
+    EXPECT_FALSE(empty.load(path + ".missing"));
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_FALSE(empty.load(path));
+
+    ASSERT_TRUE(source.save(path));
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(0);
+        file.put('X');
+    }
+    EXPECT_FALSE(empty.load(path));
+    EXPECT_EQ(empty.find_employee(ids[0]), std::nullopt);
+
+    std::filesystem::remove(path);
+}
+
+TEST(main_suite, registry_view) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "employee_lib_registry_view.bin").string();
+
+    // 1.Registry with hierarchy forest of all categories and different hire dates
+    EmployeeManager source{};
+
+    std::vector<uuid_t> ids, chiefs;
+    for (int i = 0; i < 200; ++i) {
+        const EmployeeType type = (i % 20 == 0)  ? EmployeeType::MANAGER
+                                  : (i % 5 == 0) ? EmployeeType::FOREMAN
+                                                 : EmployeeType::WORKER;
+
+        auto [id, ok] = source.add_employee(
+            {type, 1000.0 + 1.5 * i,
+             MANAGER_DESCR.hire_date + bg::months(i % 37) + bg::days(i % 28)});
+        ASSERT_TRUE(ok);
+        ids.push_back(id);
+
+        if (!chiefs.empty() && i % 50 != 0) {
+            EXPECT_TRUE(source.add_subordination(chiefs[(i * 7) % chiefs.size()], id));
+        }
+        if (type != EmployeeType::WORKER) {
+            chiefs.push_back(id);
+        }
+    }
+
+    ASSERT_TRUE(source.save(path));
+
+    // 2.Nothing is served before opening
+    EmployeeRegistryView view{};
+    EXPECT_EQ(view.size(), 0);
+    EXPECT_EQ(view.find_employee(ids[0]), std::nullopt);
+    EXPECT_FALSE(view.calculate_total_payroll(MANAGER_DESCR.hire_date).second);
+
+    // 3.Mapped registry serves the same employees, hierarchy and salaries
+    ASSERT_TRUE(view.open(path));
+    EXPECT_EQ(view.size(), ids.size());
+
+    const date_t calc_date = MANAGER_DESCR.hire_date + bg::years(5);
+    for (const uuid_t& id : ids) {
+        ASSERT_TRUE(view.find_employee(id).has_value());
+        EXPECT_EQ(view.find_employee(id)->type, source.find_employee(id)->type);
+        EXPECT_EQ(view.find_employee(id)->base_salary, source.find_employee(id)->base_salary);
+        EXPECT_EQ(view.find_employee(id)->hire_date, source.find_employee(id)->hire_date);
+        EXPECT_EQ(view.get_chief(id), source.get_chief(id));
+        EXPECT_EQ(view.count_all_subordinates(id), source.count_all_subordinates(id));
+        EXPECT_EQ(view.is_subordinate(ids[0], id), source.is_subordinate(ids[0], id));
+
+        std::vector<uuid_t> view_subordinates   = view.get_direct_subordinates(id);
+        std::vector<uuid_t> source_subordinates = source.get_direct_subordinates(id);
+        std::sort(view_subordinates.begin(), view_subordinates.end());
+        std::sort(source_subordinates.begin(), source_subordinates.end());
+        EXPECT_EQ(view_subordinates, source_subordinates);
+
+        view_subordinates   = view.get_all_subordinates(id);
+        source_subordinates = source.get_all_subordinates(id);
+        std::sort(view_subordinates.begin(), view_subordinates.end());
+        std::sort(source_subordinates.begin(), source_subordinates.end());
+        EXPECT_EQ(view_subordinates, source_subordinates);
+
+        EXPECT_EQ(view.calculate_employee_salary(id, calc_date),
+                  source.calculate_employee_salary(id, calc_date));
+    }
+    EXPECT_EQ(view.find_employee(uuid_t{}), std::nullopt);
+    EXPECT_EQ(view.calculate_total_payroll(calc_date), source.calculate_total_payroll(calc_date));
+
+    const auto [view_by_type, view_ok]     = view.calculate_payroll_by_type(calc_date);
+    const auto [source_by_type, source_ok] = source.calculate_payroll_by_type(calc_date);
+    EXPECT_EQ(view_ok, source_ok);
+    for (EmployeeType type : {EmployeeType::WORKER, EmployeeType::FOREMAN, EmployeeType::MANAGER}) {
+        EXPECT_EQ(view_by_type[type].total, source_by_type[type].total);
+        EXPECT_EQ(view_by_type[type].headcount, source_by_type[type].headcount);
+    }
+
+    // 4.Replaced file is served only after reopening
+    ASSERT_TRUE(source.remove_employee(ids[1]));
+    ASSERT_TRUE(source.save(path));
+    EXPECT_TRUE(view.find_employee(ids[1]).has_value());
+
+    ASSERT_TRUE(view.open(path));
+    EXPECT_EQ(view.find_employee(ids[1]), std::nullopt);
+    EXPECT_EQ(view.calculate_total_payroll(calc_date), source.calculate_total_payroll(calc_date));
+
+    // 5.Corrupted file is rejected and previous registry is kept
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-8, std::ios::end);
+        file.put('X');
+    }
+    EXPECT_FALSE(view.open(path));
+    EXPECT_FALSE(view.open(path + ".missing"));
+    EXPECT_EQ(view.size(), ids.size() - 1);
+
+    std::filesystem::remove(path);
+}
+
+TEST(main_suite, change_journal) {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "employee_lib_journal";
+    const std::string registry_path = (directory / "registry.bin").string();
+    const std::string journal_path  = (directory / "journal.log").string();
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+
+    const date_t calc_date = MANAGER_DESCR.hire_date + bg::years(3);
+
+    // 1.Changes of every kind are journaled (the first opening starts from empty registry)
+    std::vector<uuid_t>     ids;
+    std::pair<double, bool> payroll;
+    {
+        EmployeeManager manager{};
+        ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+        EXPECT_TRUE(std::filesystem::exists(registry_path));
+        EXPECT_FALSE(manager.load(registry_path));
+
+        ids.push_back(manager.add_employee(MANAGER_DESCR).first);
+        ids.push_back(
+            manager.add_employee({EmployeeType::FOREMAN, 200000.0, date_t{2026, 2, 28}}).first);
+
+        const std::vector<uuid_t> workers =
+            manager.add_employees({WORKER_DESCR, WORKER_DESCR, WORKER_DESCR}).first;
+        ids.insert(ids.end(), workers.begin(), workers.end());
+
+        EXPECT_TRUE(manager.add_subordination(ids[0], ids[1]));
+        EXPECT_TRUE(manager.add_subordinations({{ids[1], ids[2]}, {ids[1], ids[3]}}));
+        EXPECT_TRUE(manager.add_subordination(ids[1], ids[4]));
+        EXPECT_TRUE(manager.remove_subordination(ids[1], ids[3]));
+        EXPECT_TRUE(manager.remove_employee(ids[2]));
+
+        EXPECT_TRUE(manager.flush_journal());
+        payroll = manager.calculate_total_payroll(calc_date);
+    }
+
+    // 2.Registry is restored from registry file and journal
+    {
+        EmployeeManager manager{};
+        ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+
+        EXPECT_EQ(manager.find_employee(ids[2]), std::nullopt);
+        EXPECT_EQ(manager.find_employee(ids[1])->hire_date, date_t(2026, 2, 28));
+        EXPECT_EQ(manager.get_chief(ids[1]), ids[0]);
+        EXPECT_EQ(manager.get_chief(ids[3]), std::nullopt);
+        EXPECT_EQ(manager.get_direct_subordinates(ids[1]), std::vector<uuid_t>{ids[4]});
+        EXPECT_EQ(manager.calculate_total_payroll(calc_date), payroll);
+
+        // Changes after compaction go to the new journal (older ones are removed)
+        EXPECT_TRUE(manager.compact_journal());
+        EXPECT_TRUE(manager.add_subordination(ids[1], ids[3]));
+        EXPECT_TRUE(manager.flush_journal());
+    }
+
+    // 3.Torn record at the end of journal (crash during writing) is ignored
+    {
+        std::vector<std::filesystem::path> journals;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.path().stem() == "journal.log") {
+                journals.push_back(entry.path());
+            }
+        }
+        ASSERT_EQ(journals.size(), 1);
+
+        std::ofstream file(journals.front(), std::ios::binary | std::ios::app);
+        file.write("torn", 4);
+    }
+    {
+        EmployeeManager manager{};
+        ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+
+        EXPECT_EQ(manager.get_chief(ids[3]), ids[1]);
+        EXPECT_EQ(manager.count_all_subordinates(ids[0]), 3);
+        EXPECT_EQ(manager.find_employee(ids[1])->hire_date, date_t(2026, 2, 28));
+    }
+
+    // 4.Journal can't be used without opening and can't be opened over non-empty registry
+    EmployeeManager manager{};
+    EXPECT_FALSE(manager.flush_journal());
+    EXPECT_FALSE(manager.compact_journal());
+
+    manager.add_employee(WORKER_DESCR);
+    EXPECT_FALSE(manager.open_journal(registry_path, journal_path));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(main_suite, change_journal_failure) {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "employee_lib_journal_failure";
+    const std::string registry_path = (directory / "registry.bin").string();
+    const std::string journal_path  = (directory / "journal.log").string();
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+
+    std::vector<uuid_t> ids;
+    {
+        EmployeeManager manager{};
+        ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+
+        ids.push_back(manager.add_employee(MANAGER_DESCR).first);
+        ids.push_back(manager.add_employee(FOREMAN_DESCR).first);
+        EXPECT_TRUE(manager.add_subordination(ids[0], ids[1]));
+
+        // 1.Journal can't be switched to new file: changes are rejected (nothing is changed)
+        std::filesystem::remove_all(directory);
+        EXPECT_FALSE(manager.compact_journal());
+        EXPECT_FALSE(manager.flush_journal());
+
+        EXPECT_FALSE(manager.add_employee(WORKER_DESCR).second);
+        EXPECT_FALSE(manager.add_employees({WORKER_DESCR}).second);
+        EXPECT_FALSE(manager.remove_subordination(ids[0], ids[1]));
+        EXPECT_FALSE(manager.add_subordinations({{ids[0], ids[1]}}));
+        EXPECT_FALSE(manager.remove_employee(ids[1]));
+        EXPECT_EQ(manager.get_chief(ids[1]), ids[0]);
+
+        // 2.Successful compaction writes all changes and journal accepts changes again
+        std::filesystem::create_directory(directory);
+        EXPECT_TRUE(manager.compact_journal());
+
+        ids.push_back(manager.add_employee(WORKER_DESCR).first);
+        EXPECT_NE(ids.back(), uuid_t{});
+        EXPECT_TRUE(manager.add_subordination(ids[1], ids[2]));
+        EXPECT_TRUE(manager.flush_journal());
+    }
+
+    // 3.Every change reported as done is restored
+    EmployeeManager manager{};
+    ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+
+    EXPECT_EQ(manager.get_chief(ids[1]), ids[0]);
+    EXPECT_EQ(manager.get_chief(ids[2]), ids[1]);
+    EXPECT_EQ(manager.count_all_subordinates(ids[0]), 2);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(main_suite, change_journal_registry_failure) {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "employee_lib_journal_registry_failure";
+    const std::string registry_path = (directory / "registry.bin").string();
+    const std::string journal_path  = (directory / "journal.log").string();
+    const std::string backup_path   = (directory / "registry.bak").string();
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+
+    std::vector<uuid_t> ids;
+    {
+        EmployeeManager manager{};
+        ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+        ids.push_back(manager.add_employee(MANAGER_DESCR).first);
+
+        // 1.Registry file can't be replaced (the last durable one is kept aside for crash)
+        std::filesystem::rename(registry_path, backup_path);
+        std::filesystem::create_directory(registry_path);
+
+        EXPECT_FALSE(manager.compact_journal());
+        ids.push_back(manager.add_employee(FOREMAN_DESCR).first);
+        EXPECT_TRUE(manager.add_subordination(ids[0], ids[1]));
+
+        // 2.The next compaction fails too and must not erase changes of the previous journal
+        EXPECT_FALSE(manager.compact_journal());
+        ids.push_back(manager.add_employee(WORKER_DESCR).first);
+        EXPECT_TRUE(manager.add_subordination(ids[1], ids[2]));
+        EXPECT_TRUE(manager.flush_journal());
+    }
+
+    // 3.Crash state: the last durable registry file and all journals restore every change
+    std::filesystem::remove(registry_path);
+    std::filesystem::rename(backup_path, registry_path);
+    {
+        EmployeeManager manager{};
+        ASSERT_TRUE(manager.open_journal(registry_path, journal_path));
+
+        EXPECT_EQ(manager.get_chief(ids[1]), ids[0]);
+        EXPECT_EQ(manager.get_chief(ids[2]), ids[1]);
+        EXPECT_EQ(manager.count_all_subordinates(ids[0]), 2);
+    }
+
+    // 4.Successful compaction (by opening) leaves only journal of its generation
+    size_t journals = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        journals += entry.path().stem() == "journal.log" ? 1 : 0;
+    }
+    EXPECT_EQ(journals, 1);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(main_suite, stats) {
+    // 1.Histogram buckets: exact small values, log-linear large ones
+    for (uint64_t value : {0ull, 7ull, 8ull, 9ull, 1000ull, 123456789ull, (1ull << 40) - 1}) {
+        const size_t bucket = Histogram::bucket(value);
+
+        EXPECT_LE(value, Histogram::bucket_upper_bound(bucket));
+        EXPECT_LE(Histogram::bucket_upper_bound(bucket) - value, value / 8);
+        EXPECT_EQ(Histogram::bucket(Histogram::bucket_upper_bound(bucket)), bucket);
+    }
+    EXPECT_EQ(Histogram::bucket(UINT64_MAX), Histogram::BUCKETS_COUNT - 1);
+
+    Histogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value) {
+        ++histogram.buckets[Histogram::bucket(value)];
+        ++histogram.count;
+        histogram.sum += value;
+        histogram.max = value;
+    }
+    EXPECT_EQ(histogram.value_at_percentile(0.0), 1);
+    EXPECT_EQ(histogram.value_at_percentile(50.0), 51); // bucket [48, 51]
+    EXPECT_EQ(histogram.value_at_percentile(100.0), 100);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+
+    // 2.Manager statistics
+    EmployeeManager manager{};
+
+    const auto chief       = manager.add_employee(MANAGER_DESCR).first;
+    const auto subordinate = manager.add_employee(FOREMAN_DESCR).first;
+    const auto workers     = manager.add_employees({WORKER_DESCR, WORKER_DESCR}).first;
+
+    EXPECT_TRUE(manager.add_subordination(chief, subordinate));
+    EXPECT_TRUE(manager.add_subordinations({{subordinate, workers[0]}, {subordinate, workers[1]}}));
+    EXPECT_EQ(manager.get_all_subordinates(chief).size(), 3);
+    EXPECT_TRUE(manager.calculate_employee_salary(chief, MANAGER_DESCR.hire_date).second);
+
+    const EmployeeManagerStats stats = manager.stats();
+    if (!stats.enabled) {
+        // Instrumentation is compiled out
+        EXPECT_EQ(stats[ManagerOperation::ADD_EMPLOYEE].calls, 0);
+        EXPECT_EQ(stats.registry_lock.unique_wait.count, 0);
+        return;
+    }
+
+    EXPECT_EQ(stats[ManagerOperation::ADD_EMPLOYEE].calls, 2);
+    EXPECT_EQ(stats[ManagerOperation::ADD_EMPLOYEES].calls, 1);
+    EXPECT_EQ(stats[ManagerOperation::ADD_SUBORDINATION].calls, 1);
+    EXPECT_EQ(stats[ManagerOperation::GET_ALL_SUBORDINATES].calls, 1);
+    EXPECT_EQ(stats[ManagerOperation::CALCULATE_EMPLOYEE_SALARY].calls, 1);
+    EXPECT_EQ(stats[ManagerOperation::REMOVE_EMPLOYEE].calls, 0);
+
+    const Histogram& latency = stats[ManagerOperation::GET_ALL_SUBORDINATES].latency;
+    EXPECT_EQ(latency.count, 1);
+    EXPECT_EQ(latency.value_at_percentile(99.0), latency.max);
+
+    // Every lock is waited for and held, so both histograms have the same number of values
+    // (registrations of single employees take shared lock, batches and relations unique one)
+    EXPECT_GE(stats.registry_lock.shared_wait.count, 2);
+    EXPECT_EQ(stats.registry_lock.shared_wait.count, stats.registry_lock.shared_hold.count);
+    EXPECT_GE(stats.registry_lock.unique_wait.count, 3);
+    EXPECT_EQ(stats.registry_lock.unique_wait.count, stats.registry_lock.unique_hold.count);
+    EXPECT_EQ(stats.hierarchy_lock.shared_wait.count, stats.hierarchy_lock.shared_hold.count);
+
+    // The only walk over all subordinates visited the whole subtree of chief
+    const Histogram& subordinates = stats[HierarchyTraversal::SUBORDINATES];
+    EXPECT_EQ(subordinates.count, 1);
+    EXPECT_EQ(subordinates.sum, 3);
+}
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();